@@ -30,6 +30,7 @@
 #include <iterator>
 #include "proj_func.h"
 #include "trie_map.h"
+#include "dense_distrib.h"
 
 namespace Gambit {
 
@@ -61,6 +62,9 @@ typedef trie_map<AggNumber> aggpayoff;
 //data struct for prob distribution over configurations:
 typedef trie_map<AggNumber> aggdistrib;
 
+//the same, as a dense histogram, at nodes whose neighbors are all summed
+typedef dense_distrib<AggNumber> aggdensedistrib;
+
 //types of input formats for payoff func
 typedef enum{COMPLETE,MAPPING,ADDITIVE} payofftype; 
 
@@ -104,6 +108,10 @@ std::vector<projtype>& projTypes, int seed, bool int_payoffs=false, int int_fact
 
   //agg(const agg& other, bool completeGraph = false);
 
+  //deep copy: the projection functions are cloned, so that the copy
+  //is independent of (and may outlive) the original
+  AGG(const AGG& other);
+
 
   //destructor
   virtual ~AGG(){
@@ -156,6 +164,8 @@ std::vector<projtype>& projTypes, int seed, bool int_payoffs=false, int int_fact
   //exp. payoff under mixed strat profile
   AggNumber getMixedPayoff(int player, StrategyProfile &s);
   void getPayoffVector(AggNumberVector &dest, int player,const StrategyProfile &s);
+  //payoffs of the actions acts[k] of player, into dest[k]
+  void getPayoffVector(AggNumberVector &dest, int player, const std::vector<int> &acts, const StrategyProfile &s);
   AggNumber getV (int player, int action,const StrategyProfile &s);
   AggNumber getJ(int player,int action, int player2,int action2,StrategyProfile &s);
 
@@ -276,6 +286,34 @@ private:
   //cache of jacobian entries.
   trie_map<AggNumber> cache;
 
+  //foreach s in S, whether the configurations of s are sums of the
+  //contributions, and few enough to keep the distributions over them
+  //as dense histograms
+  std::vector<bool> isDense;
+
+  //foreach s in S with isDense[s], foreach i in N, foreach s_i in S_i,
+  //the index in the histogram of the contribution of s_i to D^(s)
+  std::vector<std::vector<std::vector<size_t> > > denseProjection;
+
+  //foreach s in S with isDense[s], the payoff of each configuration,
+  //by its index in the histogram
+  std::vector<std::vector<AggNumber> > densePayoffs;
+
+  //the induced distribution computed by computeDenseP(), and scratch space
+  aggdensedistrib densePr, denseScratch;
+  std::vector<aggdensedistrib::contribution> denseContribs;
+
+  //for the payoff vectors: foreach s in S with isDense[s], the
+  //distribution induced by all players under denseProfile, if
+  //denseFullValid[s].  The distribution induced by all players but one
+  //is then found by dividing out that player's projected strategy.
+  //Like the other working storage here, this makes the payoff methods
+  //unsafe to call from several threads at once; GameAggRep and
+  //GameBagentRep serialize them.
+  StrategyProfile denseProfile;
+  std::vector<aggdensedistrib> denseFull;
+  std::vector<bool> denseFullValid;
+
   //the unique action sets
   std::vector<ActionSet> uniqueActionSets;
 
@@ -337,6 +375,11 @@ private:
 
   //private methods:
   void computeP(int player, int act, int player2=-1,int act2=-1);
+  void initDense();
+  void computeDenseP(int player, int act, const StrategyProfile &s);
+  void getDenseContribs(int Node, int player, const StrategyProfile &s);
+  void setDenseProfile(int player, const StrategyProfile &s);
+  AggNumber getDenseV(int player, int act);
   void doProjection(int Node,const StrategyProfile& s){
 	  doProjection (Node, &(const_cast<StrategyProfile &>(s)[0]));
   }
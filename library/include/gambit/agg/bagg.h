@@ -67,6 +67,9 @@ public:
     std::vector<std::vector<std::vector<int > > > &ta2a,
     AGG* aggPtr);
 
+  //deep copy, including the underlying AGG
+  BAGG(const BAGG& other);
+
   ~BAGG(){
     delete[] typeOffset;
     delete[] strategyOffset;
@@ -0,0 +1,160 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gambit/agg/dense_distrib.h
+// Dense histograms of configurations at sum-projected action nodes
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GAMBIT_AGG_DENSEDISTRIB_H
+#define GAMBIT_AGG_DENSEDISTRIB_H
+
+#include <vector>
+#include <utility>
+
+namespace Gambit {
+
+namespace agg {
+
+//Probability distribution over the configurations at an action node
+//all of whose neighbors are combined by summing (P_SUM or P_SUM2).
+//A configuration is stored at the index sum_k c[k]*stride[k], with
+//each stride the product of the bounds on the later coordinates, so
+//that the sum of two configurations is stored at the sum of their
+//indices as long as it is within the bounds.  Convolving with the
+//projected strategy of one player is then a shifted, scaled copy of
+//the histogram for each of the player's contributions.
+//
+//Entries at or above top() are always zero; top() bounds the index of
+//the largest configuration with positive probability, and limits the
+//work done by multiply() and inner_prod().
+template <class V>
+class dense_distrib {
+public:
+  //a contribution of one player: (index of contribution, probability)
+  typedef std::pair<size_t, V> contribution;
+
+  dense_distrib() : top_(0) {}
+
+  size_t size() const { return data.size(); }
+  size_t top() const { return top_; }
+  const V& operator[](size_t i) const { return data[i]; }
+
+  //the distribution putting all its weight on the configuration at index i
+  void reset(size_t n, size_t i) {
+    data.assign(n, (V)0);
+    data[i] = (V)1;
+    top_ = i+1;
+  }
+
+  void swap(dense_distrib<V>& other) {
+    data.swap(other.data);
+    std::swap(top_, other.top_);
+  }
+
+  //set to the distribution of the sum of a configuration drawn from
+  //src and a contribution drawn from contribs.  The contributions must
+  //be such that the sums stay within the bounds of the histogram.
+  void multiply(const dense_distrib<V>& src, const std::vector<contribution>& contribs) {
+    if (data.size() != src.data.size()) {
+      data.assign(src.data.size(), (V)0);
+    }
+    else {
+      for (size_t i=0; i<top_; ++i) data[i] = (V)0;
+    }
+    top_ = 0;
+
+    const V* s = (src.data.empty()) ? 0 : &src.data[0];
+    const size_t n = src.top_;
+    for (size_t c=0; c<contribs.size(); ++c) if (contribs[c].second > (V)0) {
+      const V p = contribs[c].second;
+      V* d = &data[contribs[c].first];
+      for (size_t i=0; i<n; ++i) d[i] += p * s[i];
+      if (contribs[c].first+n > top_) top_ = contribs[c].first+n;
+    }
+  }
+
+  //the inverse of multiply(): set to the distribution which gives src
+  //when multiplied by contribs, whose offsets must be distinct.  The
+  //histogram is recovered one entry at a time, starting from the end at
+  //which the contribution with the smallest (or largest) offset has at
+  //least half of the probability, so that rounding errors do not grow.
+  //Returns false, leaving the histogram unspecified, if neither end has.
+  bool divide(const dense_distrib<V>& src, const std::vector<contribution>& contribs) {
+    V total=(V)0, plo=(V)0, phi=(V)0;
+    size_t lo=0, hi=0;
+    bool any=false;
+    for (size_t c=0; c<contribs.size(); ++c) if (contribs[c].second > (V)0) {
+      total += contribs[c].second;
+      if (!any || contribs[c].first < lo) { lo=contribs[c].first; plo=contribs[c].second; }
+      if (!any || contribs[c].first > hi) { hi=contribs[c].first; phi=contribs[c].second; }
+      any=true;
+    }
+    if (!any) return false;
+    bool forward = (plo >= total-plo);
+    if (!forward && phi < total-phi) return false;
+
+    if (data.size() != src.data.size()) {
+      data.assign(src.data.size(), (V)0);
+    }
+    else {
+      for (size_t i=0; i<top_; ++i) data[i] = (V)0;
+    }
+    top_ = (src.top_ > hi) ? src.top_-hi : 0;
+
+    if (forward) {
+      for (size_t x=0; x<top_; ++x) {
+	V v = src.data[x+lo];
+	for (size_t c=0; c<contribs.size(); ++c) {
+	  size_t d = contribs[c].first-lo;
+	  if (d > 0 && d <= x && contribs[c].second > (V)0) v -= contribs[c].second * data[x-d];
+	}
+	data[x] = v / plo;
+      }
+    }
+    else {
+      for (size_t x=top_; x-- > 0; ) {
+	V v = src.data[x+hi];
+	for (size_t c=0; c<contribs.size(); ++c) {
+	  size_t d = hi-contribs[c].first;
+	  if (d > 0 && x+d < top_ && contribs[c].second > (V)0) v -= contribs[c].second * data[x+d];
+	}
+	data[x] = v / phi;
+      }
+    }
+    return true;
+  }
+
+  //expected value of the function on configurations given by table,
+  //after adding the configuration at index offset
+  V inner_prod(const std::vector<V>& table, size_t offset=0, V init=(V)0) const {
+    V result(init);
+    const V* t = (table.empty()) ? 0 : &table[offset];
+    for (size_t i=0; i<top_; ++i) result += data[i] * t[i];
+    return result;
+  }
+
+private:
+  std::vector<V> data;
+  size_t top_;
+};
+
+}  // end namespace Gambit::agg
+
+}  // end namespace Gambit
+
+#endif  // GAMBIT_AGG_DENSEDISTRIB_H
@@ -90,6 +90,8 @@ struct proj_func{
 	}
 	virtual int operator()(int x,int y)   =0;
 	virtual int operator()(std::multiset<int>& s) =0;
+	//returns a new copy of the function, of the same type
+	virtual proj_func *clone() const =0;
 	virtual void print (std::ostream& out){
 	  out<< Type;
 	  out<<" "<<Default<<" ";
@@ -99,6 +101,7 @@ struct proj_func{
 };
 
 struct proj_func_SUM: public proj_func {
+    proj_func *clone() const {return new proj_func_SUM(*this);}
     proj_func_SUM():proj_func(P_SUM,0) {}
     inline int operator() (int x,int y){return x+y;}
     inline int operator()(std::multiset<int>& s){return s.size();}
@@ -106,6 +109,7 @@ struct proj_func_SUM: public proj_func {
 };
 
 struct proj_func_SUM2: public proj_func{
+    proj_func *clone() const {return new proj_func_SUM2(*this);}
     proj_func_SUM2(std::istream& in, int S):proj_func(P_SUM2,in,S){ }
     inline int operator()(int x, int y){return x+y;}
     inline int operator()(std::multiset<int>& s){
@@ -117,12 +121,14 @@ struct proj_func_SUM2: public proj_func{
     }
 };
 struct proj_func_EXIST: public proj_func{
+    proj_func *clone() const {return new proj_func_EXIST(*this);}
     proj_func_EXIST() :proj_func(P_EXIST,0) {}
     inline int operator() (int x, int y) {return (x+y>0);}
     inline int operator() (std::multiset<int>& s){ return (s.size()>0);}
     void print(std::ostream& out){out<<P_EXIST<<std::endl;}
 };
 struct proj_func_EXIST2: public proj_func{
+    proj_func *clone() const {return new proj_func_EXIST2(*this);}
     proj_func_EXIST2(std::istream& in, int S):proj_func(P_EXIST2,in,S){
       if (Default<0){
         std::cout<<"proj_func_EXIST2() error: default value should be nonnegative.\n";
@@ -145,6 +151,7 @@ struct proj_func_EXIST2: public proj_func{
     }
 };
 struct proj_func_HIGH:public proj_func{
+    proj_func *clone() const {return new proj_func_HIGH(*this);}
     proj_func_HIGH(int def): proj_func(P_HIGH,def) {}
     inline int operator()(int x, int y){
 	if(x==Default) return y;
@@ -158,6 +165,7 @@ struct proj_func_HIGH:public proj_func{
     void print(std::ostream& out){out<<P_HIGH<<std::endl;}
 };
 struct proj_func_HIGH2: public proj_func{
+    proj_func *clone() const {return new proj_func_HIGH2(*this);}
     proj_func_HIGH2(std::istream& in, int S):proj_func(P_HIGH2,in,S){ }
     inline int operator()(int x, int y){
       if(x==Default) return y;
@@ -175,6 +183,7 @@ struct proj_func_HIGH2: public proj_func{
     }
 };
 struct proj_func_LOW: public proj_func{
+    proj_func *clone() const {return new proj_func_LOW(*this);}
     proj_func_LOW(int def): proj_func(P_LOW,def) {}
     inline int operator()(int x, int y){
 	if (x==Default) return y;
@@ -188,6 +197,7 @@ struct proj_func_LOW: public proj_func{
     void print(std::ostream &out){out<<P_LOW <<std::endl;}
 };	
 struct proj_func_LOW2: public proj_func{
+    proj_func *clone() const {return new proj_func_LOW2(*this);}
     proj_func_LOW2(std::istream &in, int S):proj_func(P_LOW2,in,S){ }
     inline int operator()(int x, int y){
       if(x==Default) return y;
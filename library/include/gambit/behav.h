@@ -23,10 +23,13 @@
 #ifndef LIBGAMBIT_BEHAV_H
 #define LIBGAMBIT_BEHAV_H
 
+#include <random>
 #include "game.h"
 
 namespace Gambit {
 
+class GameTreeFlat;
+
 ///
 /// MixedBehaviorProfile<T> implements a randomized behavior profile on
 /// an extensive game.
@@ -60,9 +63,8 @@ protected:
   /// @name Auxiliary functions for computation of interesting values
   //@{
   void GetPayoff(GameTreeNodeRep *, const T &, int, T &) const;
+  void GetActionProbs(const GameTreeFlat &, Array<T> &) const;
   
-  void ComputeSolutionDataPass2(const GameNode &node) const;
-  void ComputeSolutionDataPass1(const GameNode &node) const;
   void ComputeSolutionData(void) const;
   //@}
 
@@ -153,6 +155,13 @@ public:
   /// Generate a random behavior strategy profile according to the uniform distribution
   /// on a grid with spacing p_denom
   void Randomize(int p_denom);
+  /// Generate a random behavior strategy profile according to the uniform
+  /// distribution, drawing from p_generator rather than std::rand()
+  void Randomize(std::mt19937 &p_generator);
+  /// Generate a random behavior strategy profile according to the uniform
+  /// distribution on a grid with spacing p_denom, drawing from p_generator
+  /// rather than std::rand()
+  void Randomize(int p_denom, std::mt19937 &p_generator);
   //@}
 
   /// @name General data access
@@ -168,6 +177,9 @@ public:
   //@{
   T GetPayoff(int p_player) const;
   T GetLiapValue(bool p_definedOnly = false) const;
+  /// Returns the gradient of GetLiapValue() with respect to the
+  /// entries of the profile
+  Vector<T> GetLiapGradient(bool p_definedOnly = false) const;
 
   const T &GetRealizProb(const GameNode &node) const;
   T GetRealizProb(const GameInfoset &iset) const;
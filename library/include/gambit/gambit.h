@@ -28,6 +28,7 @@
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <cstdio>
 #include <config.h>
 
 namespace Gambit {
@@ -45,6 +46,15 @@ template <class D, class S> D lexical_cast(const S &p_value, int p_prec)
   return s.str();
 }
 
+/// Integers are formatted without a stream, as savefiles may hold
+/// millions of them
+template <> inline std::string lexical_cast<std::string, long>(const long &p_value)
+{
+  char text[24];
+  int length = snprintf(text, sizeof(text), "%ld", p_value);
+  return std::string(text, (length > 0) ? length : 0);
+}
+
 inline double abs(double x) { return std::fabs(x); }
 
 //========================================================================
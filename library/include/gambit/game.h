@@ -40,15 +40,18 @@ namespace Gambit {
 /// be careful to check the deleted status of the object before any
 /// operations on it.
 class GameObject {
+  friend class GameRep;
 protected:
   int m_refCount;
   bool m_valid;
+  /// Set when the game containing the object has been frozen
+  bool m_frozen;
 
 public:
   /// @name Lifecycle
   //@{
   /// Constructor; initializes reference count
-  GameObject(void) : m_refCount(0), m_valid(true) { }
+  GameObject(void) : m_refCount(0), m_valid(true), m_frozen(false) { }
   /// Destructor
   virtual ~GameObject() { }
   //@}
@@ -64,12 +67,15 @@ public:
 
   /// @name Reference counting
   //@{
-  /// Increment the reference count
-  void IncRef(void) { m_refCount++; }
+  /// Increment the reference count.  Objects in a frozen game are
+  /// not reference counted.
+  void IncRef(void) { if (!m_frozen) m_refCount++; }
   /// Decrement the reference count; delete if reference count is zero.
-  void DecRef(void) { if (!--m_refCount && !m_valid) delete this; }
+  void DecRef(void) { if (!m_frozen && !--m_refCount && !m_valid) delete this; }
   /// Returns the reference count
   int RefCount(void) const { return m_refCount; }
+  /// Returns true if the game containing the object has been frozen
+  bool IsFrozen(void) const { return m_frozen; }
   //@}
 };
 
@@ -204,6 +210,8 @@ class GameOutcomeRep : public GameObject  {
   friend class GameTreeRep;
   friend class GameTableRep;
   friend class TableFileGameRep;
+  friend class StrategySupportProfile;
+  friend class GameBinaryFile;
 
 private:
   GameRep *m_game;
@@ -236,11 +244,7 @@ public:
   template <class T> const T &GetPayoff(int pl) const 
     { return (const T &) m_payoffs[pl]; }
   /// Sets the payoff to player 'pl'
-  void SetPayoff(int pl, const std::string &p_value)
-  {
-    m_payoffs[pl] = p_value;
-    //m_game->ClearComputedValues();
-  }
+  void SetPayoff(int pl, const std::string &p_value);
 
   /// Map the outcome to the corresponding outcome in the unrestricted game
   GameOutcome Unrestrict(void) const 
@@ -345,6 +349,7 @@ class GameStrategyRep : public GameObject  {
   friend class StrategySupportProfile;
   template <class T> friend class MixedStrategyProfile;
   template <class T> friend class TableMixedStrategyProfileRep;
+  template <class T> friend class TreeMixedStrategyProfileRep;
   template <class T> friend class MixedBehaviorProfile;
 
 private:
@@ -501,6 +506,10 @@ public:
 
   /// Create a separate Game object containing the subgame rooted at the node
   virtual Game CopySubgame(void) const = 0;
+  /// Create a separate Game object containing the subgame rooted at the
+  /// node.  On return, p_infosets[pl][iset] is the information set of
+  /// this game which was copied as information set iset of player pl.
+  virtual Game CopySubgame(Array<Array<GameInfoset> > &p_infosets) const = 0;
 
   virtual GameInfoset AppendMove(GamePlayer p_player, int p_actions) = 0;
   virtual GameInfoset AppendMove(GameInfoset p_infoset) = 0;
@@ -648,6 +657,7 @@ public:
 
 /// This is the class for representing an arbitrary finite game.
 class GameRep : public GameObject {
+  friend class GameOutcomeRep;
   friend class GameTreeInfosetRep;
   friend class GamePlayerRep;
   friend class GameTreeNodeRep;
@@ -672,6 +682,10 @@ protected:
   virtual void BuildComputedValues(void) { }
   /// Have computed values been built?
   virtual bool HasComputedValues(void) const { return false; }
+  /// Discard any payoff data compiled from the outcomes
+  virtual void ClearPayoffCache(void) const { }
+  /// Compile any payoff data that would otherwise be built on first use
+  virtual void BuildPayoffCache(void) const { }
   //@}
 
 
@@ -684,6 +698,23 @@ public:
   virtual Game Copy(void) const = 0;
   //@}
 
+  /// @name Sharing between threads
+  //@{
+  /// \brief Finalizes the game for read-only sharing between threads
+  ///
+  /// Canonicalizes the game and builds all values which are otherwise
+  /// computed on first use (such as the reduced strategies of a tree and
+  /// compiled payoff tables), and then marks the game and all of its
+  /// objects as frozen.  Handles to objects in a frozen game do not
+  /// update reference counts, so a frozen game can be read from any
+  /// number of threads at once.  Action-graph games compute payoffs in
+  /// working storage of their own, so they take a lock for each payoff
+  /// computation, and threads sharing one contend for it.  Freezing
+  /// cannot be undone: a frozen game must not be modified, and handles
+  /// obtained after freezing must not outlive the game.
+  void Freeze(void);
+  //@}
+
   /// @name General data access
   //@{
   /// Returns true if the game has a game tree representation
@@ -692,6 +723,9 @@ public:
   /// Returns true if the game has a action-graph game representation
   virtual bool IsAgg(void) const { return false; }
 
+  /// Returns true if the game has a Bayesian action-graph game representation
+  virtual bool IsBagg(void) const { return false; }
+
   /// Returns true if the game is a restriction of a more general game
   virtual bool IsRestriction(void) const { return false; }
   /// Returns the unrestricted version of the game
@@ -816,6 +850,11 @@ Game NewTable(const Array<int> &p_dim, bool p_sparseOutcomes = false);
 // all classes to be defined.
 
 inline Game GameOutcomeRep::GetGame(void) const { return m_game; }
+inline void GameOutcomeRep::SetPayoff(int pl, const std::string &p_value)
+{
+  m_payoffs[pl] = p_value;
+  m_game->ClearPayoffCache();
+}
 
 inline GamePlayer GameStrategyRep::GetPlayer(void) const { return m_player; }
 
@@ -839,9 +878,17 @@ template<> inline std::string PureBehaviorProfile::GetPayoff(int pl) const
 //=======================================================================
 
 
-/// Reads a game in .efg or .nfg format from the input stream
+/// Reads a game in .efg, .nfg, binary or any of the other recognized
+/// formats from the input stream.  Streams holding binary savefiles
+/// should be opened in binary mode.
 Game ReadGame(std::istream &) throw (InvalidFileException);
 
+/// Returns true if the buffer starts with the signature of a binary savefile
+bool IsBinaryGame(const char *p_data, size_t p_length);
+/// Reads a game written by Write() in "binary" format from a buffer
+Game ReadBinaryGame(const char *p_data, size_t p_length)
+  throw (InvalidFileException);
+
 } // end namespace gambit
 
 #endif   // LIBGAMBIT_GAME_H
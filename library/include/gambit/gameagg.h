@@ -23,6 +23,7 @@
 #ifndef GAMEAGG_H
 #define GAMEAGG_H
 
+#include <mutex>
 #include "gambit/agg/agg.h"
 
 namespace Gambit {
@@ -40,6 +41,9 @@ class GameAggRep : public GameRep {
 private:
   agg::AGG *aggPtr;
   Array<GamePlayerRep *> m_players;
+  /// The AGG keeps its working storage and caches in itself, so the
+  /// payoff computations on it are made one at a time
+  mutable std::mutex m_payoffMutex;
 
   /// Constructor; takes ownership of the passed pointer
   GameAggRep(agg::AGG *);
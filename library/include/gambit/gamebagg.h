@@ -23,6 +23,7 @@
 #ifndef GAMEBAGG_H
 #define GAMEBAGG_H
 
+#include <mutex>
 #include "gambit/agg/bagg.h"
 
 namespace Gambit {
@@ -36,6 +37,9 @@ private:
   agg::BAGG *baggPtr;
   Array<int> agent2baggPlayer;
   Array<GamePlayerRep *> m_players;
+  /// The BAGG keeps its working storage and caches in itself, so the
+  /// payoff computations on it are made one at a time
+  mutable std::mutex m_payoffMutex;
 
   /// Constructor; takes ownership of the passed pointer
   GameBagentRep(agg::BAGG *_baggPtr);
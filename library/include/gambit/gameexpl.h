@@ -41,6 +41,9 @@ protected:
   /// Write the game in .nfg format to the specified stream
   virtual void WriteNfgFile(std::ostream &) const
   { throw UndefinedException(); }
+  /// Write the game in binary format to the specified stream
+  virtual void WriteBinaryFile(std::ostream &) const
+  { throw UndefinedException(); }
   //@}
 
 public:
@@ -23,12 +23,14 @@
 #ifndef GAMETABLE_H
 #define GAMETABLE_H
 
+#include <vector>
 #include "gameexpl.h"
 
 namespace Gambit {
 
 class GameTableRep : public GameExplicitRep {
   friend class StrategySupportProfile;
+  friend class GameBinaryFile;
   friend class GamePlayerRep;
   friend class TablePureStrategyProfileRep;
   friend class PureStrategyProfileRep;
@@ -38,10 +40,29 @@ private:
   Array<GameOutcomeRep *> m_results;
   Game m_unrestricted;
 
+  /// @name Compiled payoff tables
+  //@{
+  /// Payoffs stored player by player, each plane indexed by the sum
+  /// of the strategy offsets of a contingency.  These are built on
+  /// first use and discarded whenever payoffs or outcomes change.
+  mutable std::vector<double> m_doublePayoffs;
+  mutable std::vector<Rational> m_rationalPayoffs;
+  //@}
+
   /// @name Private auxiliary functions
   //@{
   void IndexStrategies(void);
   void RebuildTable(void);
+  template <class T> void BuildPayoffTable(std::vector<T> &) const;
+  //@}
+
+protected:
+  /// @name Managing the representation
+  //@{
+  /// Discard the compiled payoff tables
+  virtual void ClearPayoffCache(void) const;
+  /// Build the compiled payoff tables
+  virtual void BuildPayoffCache(void) const;
   //@}
 
 public:
@@ -120,6 +141,19 @@ public:
   //@{
   /// Write the game to a file in .nfg outcome format
   virtual void WriteNfgFile(std::ostream &) const;
+  /// Write the game to a file in binary format
+  virtual void WriteBinaryFile(std::ostream &) const;
+  //@}
+
+  /// @name Compiled payoff tables
+  //@{
+  /// Returns the plane of payoffs to player pl, as a contiguous array
+  /// indexed from zero by the sum of the offsets of the strategies
+  /// in a contingency.  The pointer remains valid until the payoffs or
+  /// outcomes of the game are next modified.
+  const double *GetPayoffTable(int pl, double) const;
+  /// Returns the plane of exact payoffs to player pl
+  const Rational *GetPayoffTable(int pl, const Rational &) const;
   //@}
 
   virtual PureStrategyProfile NewPureStrategyProfile(void) const;
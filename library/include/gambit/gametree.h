@@ -23,6 +23,7 @@
 #ifndef GAMETREE_H
 #define GAMETREE_H
 
+#include <vector>
 #include "gameexpl.h"
 
 namespace Gambit {
@@ -188,6 +189,7 @@ public:
   virtual void MoveTree(GameNode src);
 
   virtual Game CopySubgame(void) const;
+  virtual Game CopySubgame(Array<Array<GameInfoset> > &p_infosets) const;
 
   virtual GameInfoset AppendMove(GamePlayer p_player, int p_actions);
   virtual GameInfoset AppendMove(GameInfoset p_infoset);
@@ -196,18 +198,113 @@ public:
 };
 
 
+///
+/// A compiled snapshot of the structure of a game tree, held as
+/// parallel arrays indexed by node number, so that quantities defined
+/// on the tree can be computed by flat loops rather than by recursing
+/// through node handles.
+///
+/// Actions are assigned "slots": those of the personal players come
+/// first, in the order in which they appear in a DVector dimensioned
+/// by GameRep::NumActions(), followed by the actions of the chance
+/// player.  Information sets are assigned slots in the same way.
+/// Only the structure of the tree is compiled; payoffs and chance
+/// probabilities are read from the outcomes and information sets when
+/// used, so that changing them does not invalidate the snapshot.
+///
+class GameTreeFlat {
+  friend class GameTreeRep;
+
+private:
+  Array<int> m_preorder, m_postorder, m_childStart, m_children;
+  Array<int> m_parent, m_child, m_actionSlot, m_infosetSlot, m_player;
+  Array<GameOutcomeRep *> m_outcome;
+  Array<GameTreeInfosetRep *> m_chanceInfosets;
+  int m_numPersonalActions, m_numPersonalInfosets, m_numActions;
+
+  GameTreeFlat(void) { }
+
+public:
+  /// Returns the number of nodes in the tree
+  int NumNodes(void) const { return m_parent.Length(); }
+  /// Returns the number of the i'th node visited in preorder
+  int GetPreorder(int i) const { return m_preorder[i]; }
+  /// Returns the number of the i'th node visited in postorder
+  int GetPostorder(int i) const { return m_postorder[i]; }
+
+  /// Returns the number of the parent of the node, or zero at the root
+  int GetParent(int n) const { return m_parent[n]; }
+  /// Returns the number of children of the node
+  int NumChildren(int n) const { return m_childStart[n+1] - m_childStart[n]; }
+  /// Returns the number of the i'th child of the node
+  int GetChild(int n, int i) const { return m_children[m_childStart[n] + i - 1]; }
+  /// Returns which child of its parent the node is (zero at the root)
+  int GetChildNumber(int n) const { return m_child[n]; }
+  /// Returns the slot of the action leading to the node (zero at the root)
+  int GetActionSlot(int n) const { return m_actionSlot[n]; }
+  /// Returns the slot of the node's information set (zero if terminal)
+  int GetInfosetSlot(int n) const { return m_infosetSlot[n]; }
+  /// Returns the player with the move at the node (zero for chance)
+  int GetPlayer(int n) const { return m_player[n]; }
+  /// Returns the outcome attached to the node, or null
+  GameOutcomeRep *GetOutcome(int n) const { return m_outcome[n]; }
+
+  /// Returns the number of action slots, including those of chance
+  int NumActionSlots(void) const { return m_numActions; }
+  /// Returns the number of action slots of the personal players
+  int NumPersonalActions(void) const { return m_numPersonalActions; }
+  /// Returns the number of information set slots of the personal players
+  int NumPersonalInfosets(void) const { return m_numPersonalInfosets; }
+  /// Returns the number of information set slots, including those of chance
+  int NumInfosetSlots(void) const
+  { return m_numPersonalInfosets + m_chanceInfosets.Length(); }
+  /// Returns the chance information sets, in the order of their slots
+  const Array<GameTreeInfosetRep *> &GetChanceInfosets(void) const
+  { return m_chanceInfosets; }
+};
+
 class GameTreeRep : public GameExplicitRep {
   friend class GameTreeNodeRep;
+  friend class GameBinaryFile;
   friend class GameTreeInfosetRep;
   friend class GameTreeActionRep;
 protected:
   mutable bool m_computedValues, m_doCanon;
   GameTreeNodeRep *m_root;
   GamePlayerRep *m_chance;
+  /// The compiled structure of the tree, built on first use, and
+  /// discarded whenever the tree or its numbering changes
+  mutable GameTreeFlat *m_flat;
+
+  /// @name Reduced normal form payoff tables
+  //@{
+  /// Payoffs of the reduced normal form, stored player by player as
+  /// for a table game.  These are built on first use, unless they
+  /// would exceed the memory budget, and discarded whenever the tree,
+  /// its payoffs or its chance probabilities change.
+  mutable std::vector<double> m_doublePayoffs;
+  mutable std::vector<Rational> m_rationalPayoffs;
+  /// The most memory, in bytes, the payoff tables may use
+  mutable size_t m_payoffTableBudget;
+  //@}
 
   /// @name Private auxiliary functions
   //@{
   void NumberNodes(GameTreeNodeRep *, int &);
+  void BuildFlatTree(void) const;
+  void ClearFlatTree(void) const;
+  /// Builds a new game containing the subtree rooted at the node
+  Game CopySubtree(GameTreeNodeRep *, Array<Array<GameInfoset> > &) const;
+  /// Returns the number of contingencies in the reduced normal form,
+  /// or zero if a table of T's for it would exceed the memory budget
+  template <class T> long NumPayoffTableEntries(void) const;
+  template <class T> void BuildPayoffTable(std::vector<T> &) const;
+  /// Adds the payoffs of the pure strategy profile to the entries
+  /// p_payoffs[0], p_payoffs[p_stride], ..., one for each player
+  template <class T>
+  void AddProfilePayoffs(const Array<GameStrategyRep *> &p_profile,
+			 T *p_payoffs, long p_stride,
+			 std::vector<std::pair<GameTreeNodeRep *, T> > &p_stack) const;
   //@}
 
   /// @name Managing the representation
@@ -217,6 +314,12 @@ protected:
   virtual void ClearComputedValues(void) const;
   /// Have computed values been built?
   virtual bool HasComputedValues(void) const { return m_computedValues; }
+  /// Discard the payoff tables, leaving the compiled structure of the
+  /// tree, which does not depend on the payoffs
+  virtual void ClearPayoffCache(void) const;
+  /// Build the compiled structure of the tree, and the payoff tables
+  /// if they fit in the memory budget
+  virtual void BuildPayoffCache(void) const;
   //@}
 
 public: 
@@ -253,6 +356,26 @@ public:
   virtual GameNode GetRoot(void) const { return m_root; } 
   /// Returns the number of nodes in the game
   int NumNodes(void) const;
+  /// Returns the compiled structure of the tree, building it if needed
+  const GameTreeFlat &GetFlatTree(void) const;
+  //@}
+
+  /// @name Reduced normal form payoff tables
+  //@{
+  /// Returns the plane of payoffs to player pl in the reduced normal
+  /// form, laid out as GameTableRep::GetPayoffTable() by the offsets of
+  /// the strategies, or null if it would not fit in the memory budget.
+  /// The pointer remains valid until the game is next modified.
+  const double *GetPayoffTable(int pl, double) const;
+  /// Returns the plane of exact payoffs to player pl, or null
+  const Rational *GetPayoffTable(int pl, const Rational &) const;
+  /// Returns the most memory, in bytes, the payoff tables may use
+  size_t GetPayoffTableBudget(void) const { return m_payoffTableBudget; }
+  /// Sets the most memory, in bytes, the payoff tables may use; zero
+  /// disables the tables.  This counts as modifying the game, and so
+  /// must be done before the game is frozen.
+  void SetPayoffTableBudget(size_t p_bytes) const
+  { m_payoffTableBudget = p_bytes; ClearPayoffCache(); }
   //@}
 
   virtual void DeleteOutcome(const GameOutcome &);
@@ -262,6 +385,7 @@ public:
   virtual void WriteEfgFile(std::ostream &) const;
   virtual void WriteEfgFile(std::ostream &, const GameNode &p_node) const;
   virtual void WriteNfgFile(std::ostream &) const;
+  virtual void WriteBinaryFile(std::ostream &) const;
   //@}
 
   /// @name Dimensions of the game
@@ -82,9 +82,33 @@ extern int      Iislong(const IntegerRep*);
 extern int      Iisdouble(const IntegerRep*);
 extern long     lg(const IntegerRep*);
 
+/// \brief An arbitrary-precision integer
+///
+/// Values which fit in a long are held inline, without allocating an
+/// IntegerRep; the heap representation is used only for values which
+/// do not fit.  Arithmetic on inline values is done directly, checking
+/// for overflow, and falls back to the multiple-precision routines
+/// only when the result would not fit.
 class Integer {
 protected:
+  /// The heap representation of the value, or null if the value is
+  /// held inline in ival
   IntegerRep *rep;
+  /// The value, when rep is null; always in [-LONG_MAX, LONG_MAX]
+  long ival;
+
+  /// @name Managing the representation
+  //@{
+  /// Sets the value to an inline value, releasing any heap representation
+  void SetInline(long);
+  /// Moves an inline value to the heap representation
+  void Expand(void);
+  /// Moves the value inline if it fits in a long
+  void Compact(void);
+  /// Returns the heap representation of the value, building it in 
+  /// p_temp if the value is held inline
+  const IntegerRep *Rep(Integer &p_temp) const;
+  //@}
 
 public:
   /// @name Lifecycle
@@ -218,11 +242,11 @@ public:
 
   // coercion & conversion
 
-  int             fits_in_long() const { return Iislong(rep); }
-  int             fits_in_double() const { return Iisdouble(rep); }
+  int             fits_in_long() const { return (rep) ? Iislong(rep) : 1; }
+  int             fits_in_double() const { return (rep) ? Iisdouble(rep) : 1; }
 
-  long		  as_long() const { return Itolong(rep); }
-  double	  as_double() const { return Itodouble(rep); }
+  long		  as_long() const { return (rep) ? Itolong(rep) : ival; }
+  double	  as_double() const { return (rep) ? Itodouble(rep) : (double) ival; }
 
   friend std::string Itoa(const Integer &x, int base /*= 10*/, int width /*= 0*/);
   friend Integer atoI(const char *s, int base/*= 10*/);
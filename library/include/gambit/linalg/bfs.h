@@ -25,6 +25,8 @@
 
 #include "gambit/gambit.h"
 #include <map>
+#include <vector>
+#include <unordered_set>
 
 namespace Gambit  {
 
@@ -56,6 +58,7 @@ public:
 
   // Provide map-like operations
   int count(int key) const { return (m_map.count(key) > 0); }
+  size_t size(void) const { return m_map.size(); }
 
   void insert(int key, const T &value) {
     m_map.erase(key);
@@ -70,6 +73,62 @@ public:
       return m_default;
     }
   }
+
+  typedef typename std::map<int, T>::const_iterator const_iterator;
+  const_iterator begin(void) const { return m_map.begin(); }
+  const_iterator end(void) const { return m_map.end(); }
+};
+
+//
+// The basis of a BFS in canonical form: the sorted indices of the basic
+// variables, together with a hash of them computed once on construction.
+// Two keys compare equal exactly when the BFSs they were built from do.
+//
+class BasisKey {
+private:
+  std::vector<int> m_indices;
+  size_t m_hash;
+
+public:
+  template <class T> explicit BasisKey(const BFS<T> &p_bfs) : m_hash(0)
+  {
+    m_indices.reserve(p_bfs.size());
+    for (typename BFS<T>::const_iterator iter = p_bfs.begin();
+	 iter != p_bfs.end(); ++iter) {
+      m_indices.push_back(iter->first);
+      m_hash = m_hash * 1000003 + (size_t) (unsigned int) iter->first;
+    }
+  }
+
+  bool operator==(const BasisKey &p_key) const
+  { return m_hash == p_key.m_hash && m_indices == p_key.m_indices; }
+  bool operator!=(const BasisKey &p_key) const  { return !(*this == p_key); }
+
+  size_t Hash(void) const { return m_hash; }
+
+  class Hasher {
+  public:
+    size_t operator()(const BasisKey &p_key) const { return p_key.Hash(); }
+  };
+};
+
+//
+// A set of bases, for recording which BFSs have already been visited
+// in constant expected time per lookup.
+//
+class BasisSet {
+private:
+  std::unordered_set<BasisKey, BasisKey::Hasher> m_keys;
+
+public:
+  /// Returns true if the basis of the BFS is in the set
+  template <class T> bool Contains(const BFS<T> &p_bfs) const
+  { return m_keys.count(BasisKey(p_bfs)) > 0; }
+  /// Adds the basis of the BFS; returns true if it was not already present
+  template <class T> bool Insert(const BFS<T> &p_bfs)
+  { return m_keys.insert(BasisKey(p_bfs)).second; }
+
+  int Length(void) const { return m_keys.size(); }
 };
 
 }  // end namespace Gambit::linalg
@@ -65,6 +65,9 @@ public:
   /// @name Raw Tableau functions
   //@{
   void Refactor(void) { T1.Refactor(); T2.Refactor(); }
+  /// Stops sharing the decompositions of the tableau copied from;
+  /// Refactor() must be called before the next pivot
+  void Detach(void) { T1.Detach(); T2.Detach(); }
   //@}
   
   /// @name Miscellaneous functions
@@ -121,6 +121,10 @@ public:
 
   // refactor 
   void refactor();
+
+  // stop referring to the decomposition this was copied from;
+  // refactor() must be called before the next solve.
+  void detach();
   
   // solve: Bk d = a
   void solve (const Vector<T> &, Vector<T> & ) const;
@@ -63,6 +63,7 @@ public:
 
   void Refactor();
   void SetRefactor(int);
+  void Detach();  // stop sharing the decomposition of the tableau copied
 
   void SetConst(const Vector<double> &bnew);
   void SetBasis( const Basis &); // set new Tableau
@@ -121,6 +122,7 @@ public:
 
   void Refactor();
   void SetRefactor(int);
+  void Detach();  // stop sharing the decomposition of the tableau copied
 
   void SetConst(const Vector<Rational> &bnew);
   void SetBasis( const Basis &); // set new Tableau
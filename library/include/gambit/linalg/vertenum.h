@@ -30,6 +30,17 @@
 namespace Gambit {
 namespace linalg {
 
+//
+// Receives the vertices found by a VertexEnumerator one at a time, in
+// the order in which they are found, as an alternative to collecting
+// them all in the enumerator's vertex lists.
+//
+template <class T> class VertexVisitor {
+public:
+  virtual ~VertexVisitor() { }
+  virtual void Visit(const BFS<T> &p_vertex) = 0;
+};
+
 //
 // This class enumerates the vertices of the convex polyhedron 
 //
@@ -37,7 +48,9 @@ namespace linalg {
 // 
 // where b <= 0.  Enumeration starts from the vertex y = 0.
 // All computation is done in the class constructor. The 
-// list of vertices can be accessed by VertexList()
+// list of vertices can be accessed by VertexList(); alternatively, if
+// a VertexVisitor is passed to the constructor, each vertex is handed
+// to it as it is found, and the lists are left empty.
 //  
 // The code is based on the reverse Pivoting algorithm of Avis 
 // and Fukuda, Discrete Computational Geom (1992) 8:295-313.
@@ -55,6 +68,7 @@ private:
   Gambit::List<Vector<T> > Verts;
   long npivots, nodes;
   Gambit::List<long> visits,branches;
+  VertexVisitor<T> *m_visitor;
 
   void Enum(void);
   void Deeper(void);
@@ -64,6 +78,7 @@ private:
 
 public:
   VertexEnumerator(const Matrix<T> &, const Vector<T> &);
+  VertexEnumerator(const Matrix<T> &, const Vector<T> &, VertexVisitor<T> &);
   VertexEnumerator(LPTableau<T> &);
   ~VertexEnumerator() { }
   
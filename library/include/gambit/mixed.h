@@ -23,7 +23,9 @@
 #ifndef LIBGAMBIT_MIXED_H
 #define LIBGAMBIT_MIXED_H
 
+#include <random>
 #include "vector.h"
+#include "matrix.h"
 #include "gameagg.h"
 #include "gamebagg.h"
 
@@ -42,6 +44,8 @@ public:
   void Normalize(void);
   void Randomize(void);
   void Randomize(int p_denom);
+  void Randomize(std::mt19937 &p_generator);
+  void Randomize(int p_denom, std::mt19937 &p_generator);
  /// Returns the probability the strategy is played
   const T &operator[](const GameStrategy &p_strategy) const
     { return m_probs[m_support.m_profileIndex[p_strategy->GetId()]]; }
@@ -52,48 +56,89 @@ public:
   virtual T GetPayoff(int pl) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const = 0;
-};
-
-template <class T> class TreeMixedStrategyProfileRep 
-  : public MixedStrategyProfileRep<T> {
-public:
-  TreeMixedStrategyProfileRep(const StrategySupportProfile &p_support)
-    : MixedStrategyProfileRep<T>(p_support)
-  { }
-  TreeMixedStrategyProfileRep(const MixedBehaviorProfile<T> &);
-  virtual ~TreeMixedStrategyProfileRep() { }
-  
-  virtual MixedStrategyProfileRep<T> *Copy(void) const;
-  virtual T GetPayoff(int pl) const;
-  virtual T GetPayoffDeriv(int pl, const GameStrategy &) const;
-  virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const;
+  /// Computes the payoffs to each of player pl's strategies in the support.
+  /// The default implementation computes each entry separately.
+  virtual Vector<T> GetPayoffVector(int pl) const;
+  /// Computes the derivatives of the strategy payoffs with respect to
+  /// the strategy probabilities.  The default implementation computes
+  /// each entry separately.
+  virtual void GetPayoffJacobian(Matrix<T> &) const;
 };
 
 template <class T> class TableMixedStrategyProfileRep
   : public MixedStrategyProfileRep<T> {
 private:
+  /// For each player, the table offsets of the strategies in the support
+  Array<Array<long> > m_offsets;
+  /// For each player, the positions in m_probs of the strategies in the support
+  Array<Array<int> > m_indices;
+
   /// @name Private recursive payoff functions
   //@{
-  /// Recursive computation of payoff to player pl
-  T GetPayoff(int pl, int index, int i) const;
+  /// Recursive computation of payoff, summing over players cur_pl down to 1
+  T GetPayoff(const T *table, long index, int cur_pl) const;
   /// Recursive computation of payoff derivative
-  void GetPayoffDeriv(int pl, int const_pl, int cur_pl, long index,
+  void GetPayoffDeriv(const T *table, int const_pl, int cur_pl, long index,
 		      const T &prob, T &value) const;
   /// Recursive computation of payoff second derivative
-  void GetPayoffDeriv(int pl, int const_pl1, int const_pl2, 
+  void GetPayoffDeriv(const T *table, int const_pl1, int const_pl2, 
 		      int cur_pl, long index, const T &prob, T &value) const;
+  /// Recursive computation of the payoffs to all strategies of const_pl
+  void GetPayoffVector(const T *table, int const_pl, int cur_pl, long index,
+		       const T &prob, Vector<T> &values) const;
+  /// Recursive computation of the payoff Jacobian entries coupling
+  /// the strategies of const_pl1 and const_pl2
+  void GetPayoffJacobian(const T *table1, const T *table2,
+			 int const_pl1, int const_pl2, int cur_pl, long index,
+			 const T &prob, Matrix<T> &jacobian) const;
   //@}
 
+protected:
+  /// Returns the plane of payoffs to player pl, laid out by the
+  /// offsets of the strategies
+  virtual const T *GetPayoffTable(int pl) const;
+
 public:
-  TableMixedStrategyProfileRep(const StrategySupportProfile &p_support)
-    : MixedStrategyProfileRep<T>(p_support)
-  { }
+  TableMixedStrategyProfileRep(const StrategySupportProfile &p_support);
   virtual ~TableMixedStrategyProfileRep() { }
 
   virtual MixedStrategyProfileRep<T> *Copy(void) const;
   virtual T GetPayoff(int pl) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const;
+  virtual Vector<T> GetPayoffVector(int pl) const;
+  virtual void GetPayoffJacobian(Matrix<T> &) const;
+};
+
+///
+/// Mixed strategy profiles on a game tree are evaluated against the
+/// payoff tables of the reduced normal form, as for a table game, when
+/// the game provides them.  Otherwise, they are evaluated by conversion
+/// to a behavior profile.
+///
+template <class T> class TreeMixedStrategyProfileRep 
+  : public TableMixedStrategyProfileRep<T> {
+private:
+  /// Makes the behavior profile play according to the pure strategy
+  /// at each information set the strategy reaches
+  static void SetPureStrategy(MixedBehaviorProfile<T> &, const GameStrategy &);
+
+protected:
+  virtual const T *GetPayoffTable(int pl) const;
+
+public:
+  TreeMixedStrategyProfileRep(const StrategySupportProfile &p_support)
+    : TableMixedStrategyProfileRep<T>(p_support)
+  { }
+  TreeMixedStrategyProfileRep(const MixedBehaviorProfile<T> &);
+  virtual ~TreeMixedStrategyProfileRep() { }
+  
+  virtual MixedStrategyProfileRep<T> *Copy(void) const;
+  virtual T GetPayoff(int pl) const;
+  virtual T GetPayoffDeriv(int pl, const GameStrategy &) const;
+  virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const;
+  virtual Vector<T> GetPayoffVector(int pl) const;
+  virtual void GetPayoffJacobian(Matrix<T> &) const;
 };
 
 template <class T> class AggMixedStrategyProfileRep
@@ -111,6 +156,8 @@ public:
   virtual T GetPayoff(int pl) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const;
+  virtual Vector<T> GetPayoffVector(int pl) const;
+  virtual void GetPayoffJacobian(Matrix<T> &) const;
 };
 
 template <class T> class BagentMixedStrategyProfileRep
@@ -128,6 +175,7 @@ public:
   virtual T GetPayoff(int pl) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const;
+  virtual Vector<T> GetPayoffVector(int pl) const;
 };
 
 /// \brief A probability distribution over strategies in a game
@@ -216,6 +264,16 @@ public:
   /// on a grid with spacing p_denom
   void Randomize(int p_denom) { m_rep->Randomize(p_denom); }
 
+  /// Generate a random mixed strategy profile according to the uniform
+  /// distribution, drawing from p_generator rather than std::rand()
+  void Randomize(std::mt19937 &p_generator) { m_rep->Randomize(p_generator); }
+
+  /// Generate a random mixed strategy profile according to the uniform
+  /// distribution on a grid with spacing p_denom, drawing from p_generator
+  /// rather than std::rand()
+  void Randomize(int p_denom, std::mt19937 &p_generator)
+  { m_rep->Randomize(p_denom, p_generator); }
+
   /// Returns the total number of strategies in the profile
   int MixedProfileLength(void) const { return m_rep->m_probs.Length(); }
 
@@ -253,6 +311,38 @@ public:
   T GetPayoff(const GameStrategy &p_strategy) const
   { return GetPayoffDeriv(p_strategy->GetPlayer()->GetNumber(), p_strategy); }
 
+  /// \brief Computes the payoffs to all of a player's strategies
+  ///
+  /// Computes the payoff to playing each of the player's strategies in
+  /// the support against the profile, in the order in which they appear
+  /// in the support.  This is equivalent to calling GetPayoff() on each
+  /// strategy, but requires only a single pass over the game.
+  Vector<T> GetPayoffVector(int pl) const
+  { return m_rep->GetPayoffVector(pl); }
+
+  /// Computes the payoffs to all of the player's strategies
+  Vector<T> GetPayoffVector(const GamePlayer &p_player) const
+  { return GetPayoffVector(p_player->GetNumber()); }
+
+  /// \brief Computes the payoffs to all strategies of all players
+  ///
+  /// Computes the payoff to playing each strategy in the support against
+  /// the profile.  The result is indexed in the same way as the profile.
+  Vector<T> GetAllStrategyValues(void) const;
+
+  /// \brief Computes the Jacobian of the strategy payoffs
+  ///
+  /// Computes, for each pair of strategies r and c in the support, the
+  /// derivative of the payoff to playing r (to the player owning r) with
+  /// respect to the probability with which c is played; entries for
+  /// strategies of the same player are zero.  Rows and columns are indexed
+  /// in the same way as the profile, and the matrix must be square of
+  /// size MixedProfileLength().  This gives all the values of
+  /// GetPayoffDeriv(pl, r, c) needed by derivative-based methods in a
+  /// single pass over the game.
+  void GetPayoffJacobian(Matrix<T> &p_jacobian) const
+  { m_rep->GetPayoffJacobian(p_jacobian); }
+
   /// \brief Computes the Lyapunov value of the profile
   ///
   /// Computes the Lyapunov value of the profile.  This is a nonnegative
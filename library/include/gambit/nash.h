@@ -186,23 +186,27 @@ protected:
   shared_ptr<StrategySolver<T> > m_solver;
 };
 
+///
+/// Computes equilibria of an extensive game by backward induction over
+/// its subgames: each subgame is solved by p_solver, with the subgames
+/// it contains replaced by the payoffs of their equilibria.  Subgames
+/// which are identical in structure and payoffs are solved only once.
+/// With p_numThreads other than 1 (zero or fewer meaning one per
+/// processor), sibling subgames are solved concurrently; p_solver must
+/// then be safe to call from several threads at once.
+///
 template <class T> class SubgameBehavSolver : public BehavSolver<T> {
 public:
   SubgameBehavSolver(shared_ptr<BehavSolver<T> > p_solver,
-		     shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0);
+		     shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+		     int p_numThreads = 1);
   virtual ~SubgameBehavSolver()  { }
 
   virtual List<MixedBehaviorProfile<T> > Solve(const BehaviorSupportProfile &) const;
 
 protected:
   shared_ptr<BehavSolver<T> > m_solver;
-
-private:
-  void SolveSubgames(const BehaviorSupportProfile &p_support,
-		     const DVector<T> &p_templateSolution,
-		     GameNode n,
-		     List<DVector<T> > &solns,
-		     List<GameOutcome> &values) const;
+  int m_numThreads;
 };
 
 //
@@ -63,10 +63,27 @@ private:
 };
 
 
+//
+// Enumerate all extreme mixed-strategy Nash equilibria of a two-player
+// game, by enumerating the vertices of the best-response polytopes and
+// matching complementary pairs.  With p_numThreads other than 1 (zero or
+// fewer meaning one per processor), the matching is shared out among
+// threads; the output does not depend on the number of threads.
+//
+// With p_stream set, only the vertices of the polytope of lower
+// dimension are kept; those of the other polytope are matched as they
+// are enumerated, and equilibria are reported as soon as they are
+// found.  Memory then grows with the smaller vertex set only.  Matching
+// is not shared out among threads in this mode, and equilibria are
+// reported in a different order if the second player has more
+// strategies than the first.
+//
 template <class T> class EnumMixedStrategySolver : public StrategySolver<T> {
 public:
-  EnumMixedStrategySolver(shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
-    : StrategySolver<T>(p_onEquilibrium) {}
+  EnumMixedStrategySolver(shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+			  int p_numThreads = 1, bool p_stream = false)
+    : StrategySolver<T>(p_onEquilibrium), m_numThreads(p_numThreads),
+      m_stream(p_stream) {}
   virtual ~EnumMixedStrategySolver() { }
 
   shared_ptr<EnumMixedStrategySolution<T> > SolveDetailed(const Game &p_game) const;
@@ -75,6 +92,12 @@ public:
   
   
 private:
+  int m_numThreads;
+  bool m_stream;
+
+  class Recorder;
+  class VertexStream;
+
   /// Implement fuzzy equality for floating-point version when testing Nashness
   static bool EqZero(const T &x);
 };
@@ -34,20 +34,32 @@ template <class T> class LemkeTableau;
 
 namespace Nash {
  
+///
+/// Finds equilibria of two-player strategic games by following
+/// Lemke-Howson paths.  When more than one equilibrium is sought, the
+/// paths leading out of each equilibrium found are followed in turn;
+/// with p_numThreads other than 1 (zero or fewer meaning one per
+/// processor), these paths are followed concurrently, and the order in
+/// which equilibria are reported may vary from run to run.
+///
 template <class T> class NashLcpStrategySolver : public StrategySolver<T> {
 public:
   NashLcpStrategySolver(int p_stopAfter, int p_maxDepth,
-			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
+			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+			int p_numThreads = 1)
     : StrategySolver<T>(p_onEquilibrium),
-      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth) { }
+      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth),
+      m_numThreads(p_numThreads) { }
   virtual ~NashLcpStrategySolver()  { }
 
   virtual List<MixedStrategyProfile<T> > Solve(const Game &) const;
 
 private:
-  int m_stopAfter, m_maxDepth;
+  int m_stopAfter, m_maxDepth, m_numThreads;
 
   class Solution;
+  class Branch;
+  class BranchTask;
 
   bool OnBFS(const Game &, linalg::LHTableau<T> &, Solution &) const;
   void AllLemke(const Game &, int j, linalg::LHTableau<T> &, Solution &, int) const;
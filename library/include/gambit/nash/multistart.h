@@ -0,0 +1,167 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gambit/nash/multistart.h
+// Solving from many starting points, in parallel
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GAMBIT_NASH_MULTISTART_H
+#define GAMBIT_NASH_MULTISTART_H
+
+#include "gambit/nash.h"
+#include "gambit/parallel.h"
+
+namespace Gambit {
+namespace Nash {
+
+///
+/// Keeps the profiles passed to it, with their labels, so that they may
+/// be passed on to another renderer later.  Profiles of the other kind
+/// are converted, as by the renderers in nash.h.
+///
+template <class T, class Profile> class ProfileRecorder;
+
+template <class T>
+class ProfileRecorder<T, MixedStrategyProfile<T> >
+  : public MixedStrategyRenderer<T> {
+public:
+  virtual ~ProfileRecorder() { }
+  using MixedStrategyRenderer<T>::Render;
+  virtual void Render(const MixedStrategyProfile<T> &p_profile,
+		      const std::string &p_label = "NE") const
+  { m_labels.push_back(p_label);  m_profiles.push_back(p_profile); }
+
+  const List<std::string> &GetLabels(void) const { return m_labels; }
+  const List<MixedStrategyProfile<T> > &GetProfiles(void) const
+  { return m_profiles; }
+
+private:
+  mutable List<std::string> m_labels;
+  mutable List<MixedStrategyProfile<T> > m_profiles;
+};
+
+template <class T>
+class ProfileRecorder<T, MixedBehaviorProfile<T> >
+  : public BehavStrategyRenderer<T> {
+public:
+  virtual ~ProfileRecorder() { }
+  using BehavStrategyRenderer<T>::Render;
+  virtual void Render(const MixedBehaviorProfile<T> &p_profile,
+		      const std::string &p_label = "NE") const
+  { m_labels.push_back(p_label);  m_profiles.push_back(p_profile); }
+
+  const List<std::string> &GetLabels(void) const { return m_labels; }
+  const List<MixedBehaviorProfile<T> > &GetProfiles(void) const
+  { return m_profiles; }
+
+private:
+  mutable List<std::string> m_labels;
+  mutable List<MixedBehaviorProfile<T> > m_profiles;
+};
+
+///
+/// Solves from each of a list of starting points, by calling Solve()
+/// for each start with a renderer of its own.  This may be run by
+/// ParallelFor(), or by calling it for each start in turn.  The
+/// profiles found from each start are passed on to p_onEquilibrium
+/// once those from all earlier starts have been, so the output does not
+/// depend on the number of threads.  An equilibrium is passed on only
+/// if some probability in it differs by more than p_tolerance from that
+/// in each equilibrium passed on before it.
+///
+template <class T, class Profile> class MultiStartTask {
+public:
+  MultiStartTask(const List<Profile> &p_starts,
+		 shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium,
+		 double p_tolerance)
+    : m_starts(p_starts), m_onEquilibrium(p_onEquilibrium),
+      m_tolerance(p_tolerance),
+      m_labels(p_starts.size()), m_profiles(p_starts.size()),
+      m_done(p_starts.size()), m_nextOutput(1)
+  {
+    for (int i = 1; i <= m_done.Length(); m_done[i++] = false);
+  }
+  virtual ~MultiStartTask() { }
+
+  void operator()(int i)
+  {
+    ProfileRecorder<T, Profile> *recorder = new ProfileRecorder<T, Profile>;
+    shared_ptr<StrategyProfileRenderer<T> > renderer(recorder);
+    Solve(m_starts[i], renderer);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_labels[i] = recorder->GetLabels();
+    m_profiles[i] = recorder->GetProfiles();
+    m_done[i] = true;
+    for (; m_nextOutput <= m_done.Length() && m_done[m_nextOutput];
+	 m_nextOutput++) {
+      Flush(m_labels[m_nextOutput], m_profiles[m_nextOutput]);
+      m_labels[m_nextOutput] = List<std::string>();
+      m_profiles[m_nextOutput] = List<Profile>();
+    }
+  }
+
+protected:
+  /// Solves from p_start, passing the profiles found to p_onEquilibrium
+  virtual void Solve(const Profile &p_start,
+		     shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium) const = 0;
+
+private:
+  const List<Profile> &m_starts;
+  shared_ptr<StrategyProfileRenderer<T> > m_onEquilibrium;
+  double m_tolerance;
+  std::mutex m_mutex;
+  Array<List<std::string> > m_labels;
+  Array<List<Profile> > m_profiles;
+  Array<bool> m_done;
+  int m_nextOutput;
+  List<Profile> m_equilibria;
+
+  void Flush(const List<std::string> &p_labels, const List<Profile> &p_profiles)
+  {
+    typename List<std::string>::const_iterator label = p_labels.begin();
+    typename List<Profile>::const_iterator profile = p_profiles.begin();
+    for (; label != p_labels.end(); ++label, ++profile) {
+      if (*label == "NE") {
+	if (IsReported(*profile))  continue;
+	m_equilibria.push_back(*profile);
+      }
+      m_onEquilibrium->Render(*profile, *label);
+    }
+  }
+
+  bool IsReported(const Profile &p_profile) const
+  {
+    const Vector<T> &probs = p_profile;
+    for (typename List<Profile>::const_iterator eqm = m_equilibria.begin();
+	 eqm != m_equilibria.end(); ++eqm) {
+      const Vector<T> &other = *eqm;
+      bool same = true;
+      for (int i = 1; same && i <= probs.Length(); i++) {
+	same = (std::fabs((double) (probs[i] - other[i])) <= m_tolerance);
+      }
+      if (same)  return true;
+    }
+    return false;
+  }
+};
+
+}  // end namespace Gambit::Nash
+}  // end namespace Gambit
+
+#endif  // GAMBIT_NASH_MULTISTART_H
@@ -39,6 +39,14 @@ public:
     : m_text(p_text), m_rational(lexical_cast<Rational>(p_text)), 
       m_double((double) m_rational)
   { }
+  /// Constructs from a value and its text, which must agree
+  Number(const std::string &p_text, const Rational &p_value)
+    : m_text(p_text), m_rational(p_value), m_double((double) p_value)
+  { }
+  explicit Number(const Rational &p_value)
+    : m_text(lexical_cast<std::string>(p_value)), m_rational(p_value),
+      m_double((double) p_value)
+  { }
   
   Number &operator=(const std::string &p_text)
   {
@@ -0,0 +1,116 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gambit/outbuf.h
+// Buffered output for writing savefiles
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_OUTBUF_H
+#define LIBGAMBIT_OUTBUF_H
+
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include "rational.h"
+
+namespace Gambit {
+
+///
+/// Collects text in a block of fixed size, which is passed on to the
+/// underlying stream whenever it fills up.  This avoids the overhead
+/// of stream formatting for each of the many small items making up a
+/// savefile, while keeping memory use bounded however large the game.
+/// The text is passed on as it stands, so that the output is the same
+/// as when writing to the stream directly.
+///
+class OutputBuffer {
+public:
+  explicit OutputBuffer(std::ostream &p_file, size_t p_capacity = 65536)
+    : m_file(p_file), m_capacity(p_capacity)
+  { m_buffer.reserve(p_capacity); }
+  ~OutputBuffer() { Flush(); }
+
+  /// Passes the text collected so far on to the stream
+  void Flush(void)
+  {
+    if (!m_buffer.empty()) {
+      m_file.write(m_buffer.data(), m_buffer.size());
+      m_buffer.clear();
+    }
+  }
+
+  OutputBuffer &operator<<(char p_value)
+  { m_buffer += p_value; return Check(); }
+  OutputBuffer &operator<<(const char *p_value)
+  { m_buffer += p_value; return Check(); }
+  OutputBuffer &operator<<(const std::string &p_value)
+  { m_buffer += p_value; return Check(); }
+  OutputBuffer &operator<<(long p_value)
+  {
+    char text[24];
+    int length = snprintf(text, sizeof(text), "%ld", p_value);
+    if (length > 0) {
+      m_buffer.append(text, length);
+    }
+    return Check();
+  }
+  OutputBuffer &operator<<(int p_value) { return *this << (long) p_value; }
+  OutputBuffer &operator<<(const Integer &p_value)
+  {
+    if (p_value.fits_in_long()) {
+      return *this << p_value.as_long();
+    }
+    m_buffer += Itoa(p_value, 10, 0);
+    return Check();
+  }
+  OutputBuffer &operator<<(const Rational &p_value)
+  {
+    *this << p_value.numerator();
+    if (p_value.denominator() != 1L) {
+      *this << '/' << p_value.denominator();
+    }
+    return *this;
+  }
+
+  /// Writes the text in double quotes, escaping any quotes within it
+  OutputBuffer &Quoted(const std::string &p_value)
+  {
+    m_buffer += '"';
+    for (size_t i = 0; i < p_value.length(); i++) {
+      if (p_value[i] == '"')  m_buffer += '\\';
+      m_buffer += p_value[i];
+    }
+    m_buffer += '"';
+    return Check();
+  }
+
+private:
+  std::ostream &m_file;
+  size_t m_capacity;
+  std::string m_buffer;
+
+  OutputBuffer &Check(void)
+  {
+    if (m_buffer.size() >= m_capacity)  Flush();
+    return *this;
+  }
+};
+
+}  // end namespace Gambit
+
+#endif  // LIBGAMBIT_OUTBUF_H
@@ -0,0 +1,218 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/parallel.h
+// Running independent tasks on a pool of threads
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_PARALLEL_H
+#define LIBGAMBIT_PARALLEL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Gambit {
+
+/// Returns the number of threads to use when the caller asks for
+/// p_threads; zero or fewer means one per hardware thread.
+inline int NumWorkerThreads(int p_threads)
+{
+  if (p_threads > 0)  return p_threads;
+  int hardware = (int) std::thread::hardware_concurrency();
+  return (hardware > 0) ? hardware : 1;
+}
+
+template <class Task> class ParallelForWorker {
+public:
+  ParallelForWorker(Task &p_task, int p_count, std::atomic<int> &p_next,
+		    std::mutex &p_mutex, std::exception_ptr &p_error)
+    : m_task(p_task), m_count(p_count), m_next(p_next),
+      m_mutex(p_mutex), m_error(p_error) { }
+
+  void operator()(void) const
+  {
+    for (int i = m_next++; i <= m_count; i = m_next++) {
+      try {
+	m_task(i);
+      }
+      catch (...) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_error)  m_error = std::current_exception();
+	// Stop handing out further work
+	m_next = m_count + 1;
+      }
+    }
+  }
+
+private:
+  Task &m_task;
+  int m_count;
+  std::atomic<int> &m_next;
+  std::mutex &m_mutex;
+  std::exception_ptr &m_error;
+};
+
+///
+/// Calls p_task(i) for each i = 1, ..., p_count, using up to p_threads
+/// threads (see NumWorkerThreads()).  Indices are handed out one at a
+/// time from a shared counter, so that threads which finish their tasks
+/// early pick up the remaining ones.  The order in which tasks run is
+/// unspecified; p_task must therefore be safe to call concurrently for
+/// different indices.  If any task throws, no further tasks are started,
+/// and the first exception is rethrown in the calling thread once all
+/// running tasks have completed.
+///
+template <class Task> void ParallelFor(int p_count, int p_threads, Task &p_task)
+{
+  int numThreads = NumWorkerThreads(p_threads);
+  if (numThreads > p_count)  numThreads = p_count;
+
+  std::atomic<int> next(1);
+  std::mutex mutex;
+  std::exception_ptr error;
+  ParallelForWorker<Task> worker(p_task, p_count, next, mutex, error);
+
+  std::vector<std::thread> threads;
+  for (int i = 1; i < numThreads; i++) {
+    threads.push_back(std::thread(worker));
+  }
+  // The calling thread takes a share of the work as well
+  worker();
+  for (size_t i = 0; i < threads.size(); i++) {
+    threads[i].join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+///
+/// A pool of work items, processed by a number of threads, where
+/// processing an item may generate further items.  Run() calls
+/// p_task(item, queue) for each item, including those pushed while it
+/// is running, and returns once the queue is empty and all threads are
+/// idle, or once Cancel() has been called and running tasks have
+/// finished.  The most recently pushed item is handed out first, so
+/// the items are explored roughly depth-first.  If any task throws, the
+/// queue is cancelled, and the first exception is rethrown by Run().
+///
+template <class Item> class WorkQueue {
+public:
+  WorkQueue(void) : m_busy(0), m_cancelled(false) { }
+
+  /// Add an item to the queue; safe to call from within a task
+  void Push(const Item &p_item)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_cancelled)  return;
+    m_items.push_back(p_item);
+    m_wakeup.notify_one();
+  }
+
+  /// Stop handing out items; items not yet started are discarded
+  void Cancel(void)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cancelled = true;
+    m_items.clear();
+    m_wakeup.notify_all();
+  }
+
+  bool IsCancelled(void) const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cancelled;
+  }
+
+  template <class Task> void Run(int p_threads, Task &p_task)
+  {
+    Worker<Task> worker(*this, p_task);
+    std::vector<std::thread> threads;
+    for (int i = 1; i < NumWorkerThreads(p_threads); i++) {
+      threads.push_back(std::thread(worker));
+    }
+    worker();
+    for (size_t i = 0; i < threads.size(); i++) {
+      threads[i].join();
+    }
+    if (m_error) {
+      std::rethrow_exception(m_error);
+    }
+  }
+
+private:
+  mutable std::mutex m_mutex;
+  std::condition_variable m_wakeup;
+  std::deque<Item> m_items;
+  int m_busy;
+  bool m_cancelled;
+  std::exception_ptr m_error;
+
+  template <class Task> class Worker {
+  public:
+    Worker(WorkQueue<Item> &p_queue, Task &p_task)
+      : m_queue(p_queue), m_task(p_task) { }
+
+    void operator()(void) const
+    {
+      std::unique_lock<std::mutex> lock(m_queue.m_mutex);
+      while (true) {
+	while (!m_queue.m_cancelled && m_queue.m_items.empty() &&
+	       m_queue.m_busy > 0) {
+	  m_queue.m_wakeup.wait(lock);
+	}
+	if (m_queue.m_cancelled || m_queue.m_items.empty()) {
+	  // Either cancelled, or no work left and nobody to create more
+	  m_queue.m_wakeup.notify_all();
+	  return;
+	}
+	Item item = m_queue.m_items.back();
+	m_queue.m_items.pop_back();
+	m_queue.m_busy++;
+	lock.unlock();
+	try {
+	  m_task(item, m_queue);
+	}
+	catch (...) {
+	  lock.lock();
+	  if (!m_queue.m_error)  m_queue.m_error = std::current_exception();
+	  m_queue.m_cancelled = true;
+	  m_queue.m_items.clear();
+	  lock.unlock();
+	}
+	lock.lock();
+	if (--m_queue.m_busy == 0 && m_queue.m_items.empty()) {
+	  m_queue.m_wakeup.notify_all();
+	}
+      }
+    }
+
+  private:
+    WorkQueue<Item> &m_queue;
+    Task &m_task;
+  };
+};
+
+}  // end namespace Gambit
+
+#endif  // LIBGAMBIT_PARALLEL_H
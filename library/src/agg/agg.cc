@@ -133,6 +133,7 @@ kSymStrategyOffset(1,0)
     for(int j=0;j<actions[i];j++)
 	node2Action[actionSets[i][j]][i]=j;
 
+  initDense();
 }
 
 /*
@@ -213,6 +214,59 @@ b    numActionNodes=other.numActionNodes;
 }
 */
 
+AGG::AGG(const AGG& other) :
+numPlayers(other.numPlayers),
+totalActions(other.totalActions),
+maxActions(other.maxActions),
+numActionNodes(other.numActionNodes),
+numPNodes(other.numPNodes),
+actionSets(other.actionSets),
+neighbors(other.neighbors),
+projectionTypes(other.projectionTypes.size()),
+payoffs(other.payoffs.size()),
+projection(other.projection),
+projectedStrat(other.projectedStrat),
+fullProjectedStrat(other.fullProjectedStrat),
+projFunctions(other.projFunctions.size()),
+Porder(other.Porder),
+Pr(other.Pr),
+isPure(other.isPure),
+node2Action(other.node2Action),
+cache(other.cache),
+uniqueActionSets(other.uniqueActionSets),
+playerClasses(other.playerClasses),
+player2Class(other.player2Class),
+numKSymActions(other.numKSymActions),
+kSymStrategyOffset(other.kSymStrategyOffset)
+{
+  actions=new int[numPlayers];
+  strategyOffset= new int[numPlayers+1];
+  copy(other.actions, other.actions+numPlayers, actions);
+  copy(other.strategyOffset, other.strategyOffset+numPlayers+1, strategyOffset);
+
+  //copying a trie_map reverses the order of its entries; insert the
+  //payoffs backwards instead, so that they are written in the same order
+  for (size_t i=0;i<payoffs.size();++i){
+    vector<aggpayoff::value_type> entries(other.payoffs[i].begin(), other.payoffs[i].end());
+    for (size_t j=entries.size();j>0;--j){
+      payoffs[i].insert(entries[j-1]);
+    }
+  }
+
+  for (size_t i=0;i<projectionTypes.size();++i){
+    projectionTypes[i]=other.projectionTypes[i]->clone();
+  }
+  //as in makeAGG(): neighbors which are action nodes are summed,
+  //the others share the projection type of the function node
+  for (size_t i=0;i<projFunctions.size();i++){
+    for (size_t j=0;j<neighbors[i].size();j++){
+      projtype t=(neighbors[i][j]<numActionNodes)?(new proj_func_SUM):projectionTypes[neighbors[i][j]-numActionNodes];
+      projFunctions[i].push_back(t);
+    }
+  }
+  initDense();
+}
+
 void AGG::stripComment(istream& in){
   in>>ws;
   char c =in.peek();
@@ -612,6 +666,159 @@ AGG::computeP(int player, int act, int player2,int act2)
     
 }
 
+//a dense histogram is used at a node only if it has at most this many
+//entries per payoff listed for the node, or at most DENSE_MIN_SIZE entries
+static const size_t DENSE_FILL = 4;
+static const size_t DENSE_MIN_SIZE = 256;
+
+void
+AGG::initDense()
+{
+  isDense.assign(numActionNodes, false);
+  denseProjection.assign(numActionNodes, vector<vector<size_t> >());
+  densePayoffs.assign(numActionNodes, vector<AggNumber>());
+  denseProfile.clear();
+  denseFull.assign(numActionNodes, aggdensedistrib());
+  denseFullValid.assign(numActionNodes, false);
+
+  for (int Node=0; Node<numActionNodes; ++Node){
+    int numNei=neighbors[Node].size();
+    bool dense=true;
+    for (int k=0; k<numNei; ++k){
+      TypeEnum t=projFunctions[Node][k]->Type;
+      if (t!=P_SUM && t!=P_SUM2) dense=false;
+    }
+
+    //the largest sum of the contributions of all players to each neighbor
+    vector<int> bound(numNei,1);
+    for (int i=0; dense && i<numPlayers; ++i){
+      for (int k=0; k<numNei; ++k){
+	int most=0;
+	for (int j=0; j<actions[i]; ++j){
+	  int c=projection[Node][i][j][k];
+	  if (c<0) dense=false;
+	  if (c>most) most=c;
+	}
+	bound[k]+=most;
+      }
+    }
+
+    size_t maxSize=max(DENSE_FILL*payoffs[Node].size(), DENSE_MIN_SIZE);
+    vector<size_t> stride(numNei);
+    size_t size=1;
+    for (int k=numNei-1; dense && k>=0; --k){
+      stride[k]=size;
+      if ((size_t) bound[k] > maxSize/size) dense=false;
+      else size*=bound[k];
+    }
+    if (!dense) continue;
+
+    isDense[Node]=true;
+    denseProjection[Node].resize(numPlayers);
+    for (int i=0; i<numPlayers; ++i){
+      denseProjection[Node][i].resize(actions[i]);
+      for (int j=0; j<actions[i]; ++j){
+	size_t index=0;
+	for (int k=0; k<numNei; ++k) index+=projection[Node][i][j][k]*stride[k];
+	denseProjection[Node][i][j]=index;
+      }
+    }
+    //configurations outside the bounds cannot occur, and are dropped
+    densePayoffs[Node].assign(size, (AggNumber)0);
+    for (aggpayoff::const_iterator p=payoffs[Node].begin(); p!=payoffs[Node].end(); ++p){
+      if ((int)p->first.size()!=numNei) continue;
+      size_t index=0;
+      int k;
+      for (k=0; k<numNei && p->first[k]>=0 && p->first[k]<bound[k]; ++k) 
+	index+=p->first[k]*stride[k];
+      if (k==numNei) densePayoffs[Node][index]=p->second;
+    }
+  }
+}
+
+//compute the induced distribution at a node with isDense set, by
+//convolving the histogram with each other player's projected strategy
+void
+AGG::computeDenseP(int player, int act, const StrategyProfile &s)
+{
+  int Node=actionSets[player][act];
+  const vector<vector<size_t> >& proj=denseProjection[Node];
+  densePr.reset(densePayoffs[Node].size(), proj[player][act]);
+
+  for (int i=0; i<numPlayers; ++i) if (i!=player){
+    getDenseContribs(Node, i, s);
+    denseScratch.multiply(densePr, denseContribs);
+    densePr.swap(denseScratch);
+  }
+}
+
+//set denseContribs to player's projected strategy at Node, with the
+//actions with the same contribution merged
+void
+AGG::getDenseContribs(int Node, int player, const StrategyProfile &s)
+{
+  const vector<size_t>& proj=denseProjection[Node][player];
+  denseContribs.clear();
+  for (int j=0; j<actions[player]; ++j) if (s[firstAction(player)+j]>(AggNumber)0){
+    size_t c=0;
+    while (c<denseContribs.size() && denseContribs[c].first!=proj[j]) ++c;
+    if (c==denseContribs.size())
+      denseContribs.push_back(make_pair(proj[j], s[firstAction(player)+j]));
+    else
+      denseContribs[c].second+=s[firstAction(player)+j];
+  }
+}
+
+//The payoffs to player do not depend on player's own strategy, so the
+//distributions in denseFull may be kept as long as the strategies of
+//the other players are unchanged; in particular, across the payoff
+//vectors of all the players under the same profile.
+void
+AGG::setDenseProfile(int player, const StrategyProfile &s)
+{
+  bool same=(denseProfile.size()==s.size());
+  for (int i=0; same && i<numPlayers; ++i) if (i!=player){
+    for (int j=firstAction(i); j<lastAction(i); ++j){
+      if (denseProfile[j]!=s[j]) {
+	same=false;
+	break;
+      }
+    }
+  }
+  if (!same){
+    denseProfile=s;
+    denseFullValid.assign(numActionNodes, false);
+  }
+}
+
+//as getV() at a node with isDense set, under denseProfile: the
+//distribution induced by the other players is that induced by all of
+//them, with player's projected strategy divided out.  This costs about
+//as much as convolving one player's strategy, rather than all of them.
+AggNumber
+AGG::getDenseV(int player, int act)
+{
+  int Node=actionSets[player][act];
+  if (!denseFullValid[Node]){
+    densePr.reset(densePayoffs[Node].size(), 0);
+    for (int i=0; i<numPlayers; ++i){
+      getDenseContribs(Node, i, denseProfile);
+      denseScratch.multiply(densePr, denseContribs);
+      densePr.swap(denseScratch);
+    }
+    denseFull[Node]=densePr;
+    denseFullValid[Node]=true;
+  }
+
+  getDenseContribs(Node, player, denseProfile);
+  if (denseScratch.divide(denseFull[Node], denseContribs)){
+    return denseScratch.inner_prod(densePayoffs[Node], denseProjection[Node][player][act]);
+  }
+  //the division would not be numerically stable
+  computeDenseP(player, act, denseProfile);
+  return densePr.inner_prod(densePayoffs[Node]);
+}
+
 void AGG:: doProjection(int Node, AggNumber* s)
 {
   for (int i=0;i<numPlayers;i++){
@@ -654,20 +861,35 @@ AggNumber AGG::getPurePayoff(int player, int *s){
 AggNumber AGG::getMixedPayoff(int player, StrategyProfile &s){
   AggNumber result=0.0;
   assert(player>=0 && player < numPlayers);
+  setDenseProfile(player, s);
   for (int act=0;act <actions[player];++act)if (s[act+firstAction(player)]>(AggNumber)0.0){
-	result+= s[act+firstAction(player)]* getV(player, act, s);
+	result+= s[act+firstAction(player)]* 
+	  (isDense[actionSets[player][act]] ? getDenseV(player, act) : getV(player, act, s));
   }
   return result;
 }
 
 void AGG::getPayoffVector(AggNumberVector &dest, int player,const StrategyProfile &s){
     assert(player>=0 && player < numPlayers);
+    setDenseProfile(player, s);
     for (int act=0;act<actions[player]; ++act){
-	dest[act]=getV(player,act,s);
+	dest[act]=isDense[actionSets[player][act]] ? getDenseV(player, act) : getV(player,act,s);
+    }
+}
+
+void AGG::getPayoffVector(AggNumberVector &dest, int player, const vector<int> &acts, const StrategyProfile &s){
+    assert(player>=0 && player < numPlayers);
+    setDenseProfile(player, s);
+    for (size_t k=0;k<acts.size(); ++k){
+	dest[k]=isDense[actionSets[player][acts[k]]] ? getDenseV(player, acts[k]) : getV(player,acts[k],s);
     }
 }
 
 AggNumber AGG::getV(int player, int act,const StrategyProfile &s){
+    if (isDense[actionSets.at(player).at(act)]){
+	computeDenseP(player, act, s);
+	return densePr.inner_prod(densePayoffs[actionSets[player][act]]);
+    }
     //project s to the projectedStrat
     doProjection(actionSets.at(player).at(act), s);
     computeP(player, act);
@@ -48,6 +48,24 @@ BAGG::BAGG(int N, int S,
 }
 
 
+BAGG::BAGG(const BAGG& other):
+  numPlayers(other.numPlayers),
+  numActionNodes(other.numActionNodes),
+  numTypes(other.numTypes),
+  indepTypeDist(other.indepTypeDist),
+  typeActionSets(other.typeActionSets),
+  typeAction2ActionIndex(other.typeAction2ActionIndex),
+  aggPtr(new AGG(*other.aggPtr)),
+  symmetric(other.symmetric)
+{
+  typeOffset=new int[numPlayers+1];
+  copy(other.typeOffset, other.typeOffset+numPlayers+1, typeOffset);
+  strategyOffset=new int[typeOffset[numPlayers]+1];
+  copy(other.strategyOffset, other.strategyOffset+typeOffset[numPlayers]+1,
+       strategyOffset);
+}
+
+
 void BAGG::stripComment(istream& in){
   in>>ws;
   char c =in.peek();
@@ -235,17 +253,23 @@ AggNumber BAGG::getMixedPayoff(int player, StrategyProfile &s){
 
 AggNumber BAGG::getMixedPayoff(int player,int tp, StrategyProfile &s){
     AggNumber res(0);
+    AggNumberVector v(typeActionSets[player][tp].size());
+    getPayoffVector(v, player, tp, s);
     for (size_t act=0;act<typeActionSets[player][tp].size(); ++act)
 	if (s[act+firstAction(player,tp)]>AggNumber(0.0))
-	    res+= s[act+firstAction(player,tp)] * getV(player,tp,act,s);
+	    res+= s[act+firstAction(player,tp)] * v[act];
     return res;
 }
 
 void BAGG::getPayoffVector(AggNumberVector &dest, int player,int tp, const StrategyProfile &s){
     assert(player>=0&&player < getNumPlayers() && tp>=0 && tp<getNumTypes(player));
-    for(size_t act=0;act<typeActionSets[player][tp].size(); ++act){
-      dest[act] = getV(player,tp,act,s);
-    }
+    if (typeActionSets[player][tp].empty()) return;
+    //the payoffs do not depend on the player's own strategy in the AGG,
+    //so the same AGG strategy profile serves for all the actions of all
+    //the players, and the AGG can share its work between them
+    StrategyProfile as(aggPtr->getNumActions());
+    getAGGStrat(as, s);
+    aggPtr->getPayoffVector(dest, player, typeAction2ActionIndex[player][tp], as);
 }
 
 void BAGG::getAGGStrat(StrategyProfile &as, const StrategyProfile &s, int player, int tp, int action){
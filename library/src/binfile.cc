@@ -0,0 +1,595 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/binfile.cc
+// Reading and writing games in binary format
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+//
+// Layout of binary savefiles, version 2.  Integers are 32-bit unsigned
+// and little-endian, and doubles are little-endian IEEE 754.  Strings
+// are written as their length followed by their bytes.  Payoffs are
+// written as a tag byte followed by
+//   0: a 32-bit signed integer,
+//   1: a 32-bit signed numerator and a 32-bit denominator, or
+//   2: the text of the number,
+// where the first two forms are used only when the text of the number is
+// exactly how that integer or fraction prints, so that payoffs read back
+// exactly as entered.  Chance probabilities are written as their text.
+//
+//   "\x89GBF", version, kind ('N' for tables, 'E' for trees, one byte)
+//   title, comment
+//   number of players, then the label of each player
+//
+// Tables continue with
+//   for each player, the number of strategies, then the label of each
+//   number of outcomes, then for each its label and one payoff per player
+//   number of contingencies, then for each the number of its outcome,
+//     or zero if it has none
+//   for each player, one double per contingency, giving the payoffs in
+//     the layout of GameTableRep::GetPayoffTable()
+//
+// Trees continue with
+//   for chance and then each player, the number of information sets,
+//     then for each its label, number of actions, and the label of each
+//     action, followed for chance by the probability of each action
+//   outcomes, as for tables
+//   number of nodes, then for each node in preorder its label, the
+//     number of its outcome (or zero), the mover (zero at terminal
+//     nodes, one for chance, and pl + 1 for player pl), and, except at
+//     terminal nodes, the number of its information set
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include "gambit/gambit.h"
+#include "gambit/gametable.h"
+#include "gambit/gametree.h"
+
+namespace Gambit {
+
+namespace {
+
+const char BinarySignature[4] = { '\x89', 'G', 'B', 'F' };
+const unsigned int BinaryVersion = 2;
+
+/// Tags for the encodings of payoffs
+enum { NumberInteger = 0, NumberFraction = 1, NumberText = 2 };
+
+bool IsLittleEndian(void)
+{
+  const unsigned int one = 1;
+  return (*(const unsigned char *) &one == 1);
+}
+
+class BinaryWriter {
+private:
+  std::ostream &m_file;
+
+public:
+  BinaryWriter(std::ostream &p_file) : m_file(p_file) { }
+
+  void WriteByte(unsigned char p_value) { m_file.put((char) p_value); }
+  void WriteInt(unsigned int p_value)
+  {
+    char bytes[4];
+    for (int i = 0; i < 4; i++, p_value >>= 8) {
+      bytes[i] = (char) (p_value & 0xFF);
+    }
+    m_file.write(bytes, 4);
+  }
+  void WriteString(const std::string &p_value)
+  {
+    WriteInt((unsigned int) p_value.length());
+    m_file.write(p_value.data(), p_value.length());
+  }
+  void WriteDoubles(const double *p_values, size_t p_count);
+};
+
+void BinaryWriter::WriteDoubles(const double *p_values, size_t p_count)
+{
+  if (IsLittleEndian()) {
+    m_file.write((const char *) p_values, p_count * sizeof(double));
+    return;
+  }
+  for (size_t i = 0; i < p_count; i++) {
+    char bytes[sizeof(double)];
+    memcpy(bytes, p_values + i, sizeof(double));
+    std::reverse(bytes, bytes + sizeof(double));
+    m_file.write(bytes, sizeof(double));
+  }
+}
+
+class BinaryReader {
+private:
+  const char *m_current, *m_end;
+
+  void Require(size_t p_bytes, size_t p_count = 1) const
+  {
+    if (p_count > 0 && (size_t) (m_end - m_current) / p_count < p_bytes) {
+      throw InvalidFileException("Unexpected end of binary savefile");
+    }
+  }
+
+public:
+  BinaryReader(const char *p_begin, const char *p_end)
+    : m_current(p_begin), m_end(p_end) { }
+
+  bool AtEnd(void) const { return m_current == m_end; }
+  size_t Remaining(void) const { return m_end - m_current; }
+  void Skip(size_t p_bytes) { Require(p_bytes); m_current += p_bytes; }
+
+  unsigned char ReadByte(void)
+  { Require(1); return (unsigned char) *m_current++; }
+  unsigned int ReadInt(void)
+  {
+    Require(4);
+    const unsigned char *bytes = (const unsigned char *) m_current;
+    m_current += 4;
+    return (bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) |
+	    ((unsigned int) bytes[3] << 24));
+  }
+  int ReadSignedInt(void) { return (int) ReadInt(); }
+  /// Reads an integer which must be at most p_max
+  unsigned int ReadInt(unsigned int p_max)
+  {
+    unsigned int value = ReadInt();
+    if (value > p_max) {
+      throw InvalidFileException("Index out of range in binary savefile");
+    }
+    return value;
+  }
+  /// Reads the length of a list whose entries take at least
+  /// p_bytes each, checking that the list can fit in the file
+  unsigned int ReadCount(size_t p_bytes)
+  {
+    unsigned int count = ReadInt();
+    Require(p_bytes, count);
+    return count;
+  }
+  std::string ReadString(void)
+  {
+    unsigned int length = ReadInt();
+    Require(length);
+    std::string value(m_current, length);
+    m_current += length;
+    return value;
+  }
+  void ReadDoubles(double *p_values, size_t p_count);
+};
+
+void BinaryReader::ReadDoubles(double *p_values, size_t p_count)
+{
+  Require(sizeof(double), p_count);
+  if (IsLittleEndian()) {
+    memcpy(p_values, m_current, p_count * sizeof(double));
+    m_current += p_count * sizeof(double);
+    return;
+  }
+  for (size_t i = 0; i < p_count; i++, m_current += sizeof(double)) {
+    char bytes[sizeof(double)];
+    memcpy(bytes, m_current, sizeof(double));
+    std::reverse(bytes, bytes + sizeof(double));
+    memcpy(p_values + i, bytes, sizeof(double));
+  }
+}
+
+/// Returns true if p_value fits in a signed 32-bit integer
+bool FitsInInt(const Integer &p_value)
+{
+  return (p_value.fits_in_long() && p_value.as_long() >= -2147483647L &&
+	  p_value.as_long() <= 2147483647L);
+}
+
+void WriteNumber(BinaryWriter &p_writer, const std::string &p_text,
+		 const Rational &p_value)
+{
+  const Integer &num = p_value.numerator(), &den = p_value.denominator();
+  if (FitsInInt(num) && FitsInInt(den)) {
+    std::string text = lexical_cast<std::string>(num.as_long());
+    if (den == 1 && p_text == text) {
+      p_writer.WriteByte(NumberInteger);
+      p_writer.WriteInt((unsigned int) num.as_long());
+      return;
+    }
+    text += "/" + lexical_cast<std::string>(den.as_long());
+    if (p_text == text) {
+      p_writer.WriteByte(NumberFraction);
+      p_writer.WriteInt((unsigned int) num.as_long());
+      p_writer.WriteInt((unsigned int) den.as_long());
+      return;
+    }
+  }
+  p_writer.WriteByte(NumberText);
+  p_writer.WriteString(p_text);
+}
+
+Number ReadNumber(BinaryReader &p_reader)
+{
+  switch (p_reader.ReadByte()) {
+  case NumberInteger: {
+    long num = p_reader.ReadSignedInt();
+    return Number(lexical_cast<std::string>(num), Rational(num));
+  }
+  case NumberFraction: {
+    long num = p_reader.ReadSignedInt(), den = p_reader.ReadSignedInt();
+    if (den < 1) {
+      throw InvalidFileException("Invalid denominator in binary savefile");
+    }
+    return Number(lexical_cast<std::string>(num) + "/" +
+		  lexical_cast<std::string>(den), Rational(num, den));
+  }
+  case NumberText:
+    return Number(p_reader.ReadString());
+  default:
+    throw InvalidFileException("Unknown encoding of number in binary savefile");
+  }
+}
+
+void WriteOutcomes(BinaryWriter &p_writer, const GameRep &p_game)
+{
+  p_writer.WriteInt(p_game.NumOutcomes());
+  for (int outc = 1; outc <= p_game.NumOutcomes(); outc++) {
+    GameOutcome outcome = p_game.GetOutcome(outc);
+    p_writer.WriteString(outcome->GetLabel());
+    for (int pl = 1; pl <= p_game.NumPlayers(); pl++) {
+      WriteNumber(p_writer, outcome->GetPayoff<std::string>(pl),
+		  outcome->GetPayoff<Rational>(pl));
+    }
+  }
+}
+
+}  // end anonymous namespace
+
+//========================================================================
+//                         class GameBinaryFile
+//========================================================================
+
+class GameBinaryFile {
+public:
+  static void WriteHeader(BinaryWriter &, const GameRep &, char p_kind);
+  static void WriteTable(BinaryWriter &, const GameTableRep &);
+  static void WriteTree(BinaryWriter &, const GameTreeRep &);
+
+  static void ReadOutcomes(BinaryReader &, GameRep *p_game,
+			   Array<GameOutcomeRep *> &p_outcomes);
+
+  static Game ReadTable(BinaryReader &, const std::string &p_title,
+			const std::string &p_comment,
+			const Array<std::string> &p_players);
+  static Game ReadTree(BinaryReader &, const std::string &p_title,
+		       const std::string &p_comment,
+		       const Array<std::string> &p_players);
+};
+
+void GameBinaryFile::WriteHeader(BinaryWriter &p_writer, const GameRep &p_game,
+				 char p_kind)
+{
+  for (int i = 0; i < 4; p_writer.WriteByte(BinarySignature[i++]));
+  p_writer.WriteInt(BinaryVersion);
+  p_writer.WriteByte(p_kind);
+  p_writer.WriteString(p_game.GetTitle());
+  p_writer.WriteString(p_game.GetComment());
+  p_writer.WriteInt(p_game.NumPlayers());
+  for (int pl = 1; pl <= p_game.NumPlayers(); pl++) {
+    p_writer.WriteString(p_game.GetPlayer(pl)->GetLabel());
+  }
+}
+
+void GameBinaryFile::ReadOutcomes(BinaryReader &p_reader, GameRep *p_game,
+				  Array<GameOutcomeRep *> &p_outcomes)
+{
+  // Outcomes are created in one go, as files written from games in
+  // payoff format may have one for each contingency
+  int numPlayers = p_game->NumPlayers();
+  p_outcomes = Array<GameOutcomeRep *>(p_reader.ReadCount(4 + 5 * numPlayers));
+  for (int outc = 1; outc <= p_outcomes.Length(); outc++) {
+    p_outcomes[outc] = new GameOutcomeRep(p_game, outc);
+  }
+  for (int outc = 1; outc <= p_outcomes.Length(); outc++) {
+    GameOutcomeRep *outcome = p_outcomes[outc];
+    outcome->m_label = p_reader.ReadString();
+    for (int pl = 1; pl <= numPlayers; pl++) {
+      outcome->m_payoffs[pl] = ReadNumber(p_reader);
+    }
+  }
+}
+
+void GameBinaryFile::WriteTable(BinaryWriter &p_writer,
+				const GameTableRep &p_nfg)
+{
+  WriteHeader(p_writer, p_nfg, 'N');
+  for (int pl = 1; pl <= p_nfg.NumPlayers(); pl++) {
+    GamePlayerRep *player = p_nfg.m_players[pl];
+    p_writer.WriteInt(player->NumStrategies());
+    for (int st = 1; st <= player->NumStrategies(); st++) {
+      p_writer.WriteString(player->GetStrategy(st)->GetLabel());
+    }
+  }
+  WriteOutcomes(p_writer, p_nfg);
+
+  long ncont = p_nfg.m_results.Length();
+  p_writer.WriteInt((unsigned int) ncont);
+  for (long cont = 1; cont <= ncont; cont++) {
+    GameOutcomeRep *outcome = p_nfg.m_results[cont];
+    p_writer.WriteInt((outcome) ? outcome->GetNumber() : 0);
+  }
+  for (int pl = 1; pl <= p_nfg.NumPlayers(); pl++) {
+    p_writer.WriteDoubles(p_nfg.GetPayoffTable(pl, 0.0), ncont);
+  }
+}
+
+Game GameBinaryFile::ReadTable(BinaryReader &p_reader,
+			       const std::string &p_title,
+			       const std::string &p_comment,
+			       const Array<std::string> &p_players)
+{
+  Array<Array<std::string> > strategies(p_players.Length());
+  Array<int> dim(p_players.Length());
+  for (int pl = 1; pl <= p_players.Length(); pl++) {
+    dim[pl] = p_reader.ReadCount(4);
+    for (int st = 1; st <= dim[pl]; st++) {
+      strategies[pl].Append(p_reader.ReadString());
+    }
+  }
+
+  // Each contingency takes an outcome number and a payoff per player
+  double ncont = 1.0;
+  for (int pl = 1; pl <= dim.Length(); ncont *= dim[pl++]);
+  if (dim.Length() == 0 || ncont == 0.0 ||
+      ncont * (4 + 8 * dim.Length()) > (double) p_reader.Remaining()) {
+    throw InvalidFileException("Number of contingencies does not match strategies");
+  }
+
+  GameTableRep *nfg = new GameTableRep(dim, true);
+  Game game = nfg;
+  nfg->SetTitle(p_title);
+  nfg->SetComment(p_comment);
+  for (int pl = 1; pl <= p_players.Length(); pl++) {
+    nfg->m_players[pl]->SetLabel(p_players[pl]);
+    for (int st = 1; st <= dim[pl]; st++) {
+      nfg->m_players[pl]->GetStrategy(st)->SetLabel(strategies[pl][st]);
+    }
+  }
+  ReadOutcomes(p_reader, nfg, nfg->m_outcomes);
+
+  long numConts = nfg->m_results.Length();
+  if (p_reader.ReadInt() != (unsigned int) numConts) {
+    throw InvalidFileException("Number of contingencies does not match strategies");
+  }
+  for (long cont = 1; cont <= numConts; cont++) {
+    unsigned int outc = p_reader.ReadInt(nfg->m_outcomes.Length());
+    nfg->m_results[cont] = (outc > 0) ? nfg->m_outcomes[outc] : 0;
+  }
+
+  // The payoff planes are kept, rather than compiled again on first use,
+  // once they are found to agree with the outcomes
+  std::vector<double> &payoffs = nfg->m_doublePayoffs;
+  payoffs.resize(numConts * nfg->NumPlayers());
+  p_reader.ReadDoubles(&payoffs[0], payoffs.size());
+  for (long cont = 1; cont <= numConts; cont++) {
+    GameOutcomeRep *outcome = nfg->m_results[cont];
+    for (int pl = 1; pl <= nfg->NumPlayers(); pl++) {
+      double payoff = (outcome) ? outcome->GetPayoff<double>(pl) : 0.0;
+      if (payoffs[(pl - 1) * numConts + cont - 1] != payoff) {
+	throw InvalidFileException("Payoff table does not match outcomes");
+      }
+    }
+  }
+  return game;
+}
+
+void GameBinaryFile::WriteTree(BinaryWriter &p_writer, const GameTreeRep &p_efg)
+{
+  WriteHeader(p_writer, p_efg, 'E');
+  for (int pl = 0; pl <= p_efg.NumPlayers(); pl++) {
+    GamePlayer player = (pl == 0) ? p_efg.GetChance() : p_efg.GetPlayer(pl);
+    p_writer.WriteInt(player->NumInfosets());
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      GameInfoset infoset = player->GetInfoset(iset);
+      p_writer.WriteString(infoset->GetLabel());
+      p_writer.WriteInt(infoset->NumActions());
+      for (int act = 1; act <= infoset->NumActions(); act++) {
+	p_writer.WriteString(infoset->GetAction(act)->GetLabel());
+      }
+      if (pl == 0) {
+	for (int act = 1; act <= infoset->NumActions(); act++) {
+	  p_writer.WriteString(infoset->GetActionProb(act, ""));
+	}
+      }
+    }
+  }
+  WriteOutcomes(p_writer, p_efg);
+
+  p_writer.WriteInt(p_efg.NumNodes());
+  std::vector<GameNodeRep *> stack(1, p_efg.GetRoot());
+  while (!stack.empty()) {
+    GameNodeRep *node = stack.back();
+    stack.pop_back();
+    p_writer.WriteString(node->GetLabel());
+    p_writer.WriteInt((node->GetOutcome()) ? node->GetOutcome()->GetNumber() : 0);
+    if (node->NumChildren() == 0) {
+      p_writer.WriteInt(0);
+      continue;
+    }
+    GameInfoset infoset = node->GetInfoset();
+    p_writer.WriteInt(infoset->GetPlayer()->GetNumber() + 1);
+    p_writer.WriteInt(infoset->GetNumber());
+    for (int i = node->NumChildren(); i >= 1; i--) {
+      stack.push_back(node->GetChild(i));
+    }
+  }
+}
+
+Game GameBinaryFile::ReadTree(BinaryReader &p_reader,
+			      const std::string &p_title,
+			      const std::string &p_comment,
+			      const Array<std::string> &p_players)
+{
+  GameTreeRep *efg = new GameTreeRep;
+  Game game = efg;
+  efg->SetCanonicalization(false);
+  efg->SetTitle(p_title);
+  efg->SetComment(p_comment);
+  for (int pl = 1; pl <= p_players.Length(); pl++) {
+    efg->NewPlayer()->SetLabel(p_players[pl]);
+  }
+
+  // Information sets are created when their first member is read;
+  // until then, only their descriptions are kept
+  struct InfosetData {
+    std::string m_label;
+    Array<std::string> m_actions, m_probs;
+    GameInfoset m_infoset;
+  };
+  std::vector<std::vector<InfosetData> > infosets(p_players.Length() + 1);
+  for (int pl = 0; pl <= p_players.Length(); pl++) {
+    infosets[pl].resize(p_reader.ReadCount(8));
+    for (size_t iset = 0; iset < infosets[pl].size(); iset++) {
+      InfosetData &data = infosets[pl][iset];
+      data.m_label = p_reader.ReadString();
+      unsigned int numActions = p_reader.ReadCount(4);
+      for (unsigned int act = 1; act <= numActions; act++) {
+	data.m_actions.Append(p_reader.ReadString());
+      }
+      if (pl == 0) {
+	for (unsigned int act = 1; act <= numActions; act++) {
+	  data.m_probs.Append(p_reader.ReadString());
+	}
+      }
+    }
+  }
+  ReadOutcomes(p_reader, efg, efg->m_outcomes);
+
+  unsigned int numNodes = p_reader.ReadInt(), nodesRead = 0;
+  std::vector<GameNodeRep *> stack(1, efg->GetRoot());
+  while (!stack.empty()) {
+    if (++nodesRead > numNodes) {
+      throw InvalidFileException("Number of nodes does not match tree");
+    }
+    GameNodeRep *node = stack.back();
+    stack.pop_back();
+    node->SetLabel(p_reader.ReadString());
+    unsigned int outc = p_reader.ReadInt(efg->NumOutcomes());
+    if (outc > 0) {
+      node->SetOutcome(efg->GetOutcome(outc));
+    }
+    unsigned int mover = p_reader.ReadInt(p_players.Length() + 1);
+    if (mover == 0) {
+      continue;
+    }
+    unsigned int iset = p_reader.ReadInt(infosets[mover - 1].size());
+    if (iset == 0) {
+      throw InvalidFileException("Index out of range in binary savefile");
+    }
+    InfosetData &data = infosets[mover - 1][iset - 1];
+    if (data.m_actions.Length() == 0) {
+      throw InvalidFileException("Information set with no actions");
+    }
+    if (data.m_infoset) {
+      node->AppendMove(data.m_infoset);
+    }
+    else {
+      GamePlayer player = (mover == 1) ? efg->GetChance() : efg->GetPlayer(mover - 1);
+      data.m_infoset = node->AppendMove(player, data.m_actions.Length());
+      data.m_infoset->SetLabel(data.m_label);
+      for (int act = 1; act <= data.m_actions.Length(); act++) {
+	data.m_infoset->GetAction(act)->SetLabel(data.m_actions[act]);
+	if (mover == 1) {
+	  data.m_infoset->SetActionProb(act, data.m_probs[act]);
+	}
+      }
+    }
+    for (int i = node->NumChildren(); i >= 1; i--) {
+      stack.push_back(node->GetChild(i));
+    }
+  }
+  if (nodesRead != numNodes) {
+    throw InvalidFileException("Number of nodes does not match tree");
+  }
+
+  efg->SetCanonicalization(true);
+  return game;
+}
+
+//========================================================================
+//                     Writing and reading binary files
+//========================================================================
+
+void GameTableRep::WriteBinaryFile(std::ostream &p_file) const
+{
+  BinaryWriter writer(p_file);
+  GameBinaryFile::WriteTable(writer, *this);
+}
+
+void GameTreeRep::WriteBinaryFile(std::ostream &p_file) const
+{
+  BinaryWriter writer(p_file);
+  GameBinaryFile::WriteTree(writer, *this);
+}
+
+bool IsBinaryGame(const char *p_data, size_t p_length)
+{
+  return (p_length >= 4 && memcmp(p_data, BinarySignature, 4) == 0);
+}
+
+Game ReadBinaryGame(const char *p_data, size_t p_length)
+  throw (InvalidFileException)
+{
+  if (!IsBinaryGame(p_data, p_length)) {
+    throw InvalidFileException("Not a binary savefile");
+  }
+  BinaryReader reader(p_data, p_data + p_length);
+  try {
+    reader.Skip(4);
+    if (reader.ReadInt() != BinaryVersion) {
+      throw InvalidFileException("Unsupported version of binary savefile");
+    }
+    char kind = (char) reader.ReadByte();
+    std::string title = reader.ReadString();
+    std::string comment = reader.ReadString();
+    Array<std::string> players(reader.ReadCount(4));
+    for (int pl = 1; pl <= players.Length(); pl++) {
+      players[pl] = reader.ReadString();
+    }
+
+    Game game;
+    if (kind == 'N') {
+      game = GameBinaryFile::ReadTable(reader, title, comment, players);
+    }
+    else if (kind == 'E') {
+      game = GameBinaryFile::ReadTree(reader, title, comment, players);
+    }
+    else {
+      throw InvalidFileException("Unknown kind of game in binary savefile");
+    }
+    if (!reader.AtEnd()) {
+      throw InvalidFileException("Unexpected data after game in binary savefile");
+    }
+    return game;
+  }
+  catch (InvalidFileException &) {
+    throw;
+  }
+  catch (std::exception &ex) {
+    throw InvalidFileException(ex.what());
+  }
+}
+
+}  // end namespace Gambit
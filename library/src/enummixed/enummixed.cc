@@ -20,7 +20,11 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <limits>
+#include <vector>
+
 #include "gambit/gambit.h"
+#include "gambit/parallel.h"
 #include "gambit/linalg/vertenum.imp"
 #include "gambit/nash/enummixed.h"
 #include "clique.h"
@@ -30,6 +34,233 @@ namespace Nash {
 
 using namespace Gambit::linalg;
 
+namespace {
+
+const int c_bitsPerWord = std::numeric_limits<unsigned long>::digits;
+
+//
+// A vertex of one of the polytopes, with its basic variables recorded
+// as bitsets: m_basic over the vertex's coordinates, which are indexed
+// by the player's own strategies, and m_slack over its slack variables,
+// which are indexed by the opponent's strategies (and appear in the BFS
+// with negative indices).  The values of the basic variables are kept
+// alongside, so that a pair sharing basic labels can still be checked
+// for complementarity exactly as before.
+//
+template <class T> class LabeledVertex {
+public:
+  std::vector<unsigned long> m_basic, m_slack;
+  Array<T> m_values, m_slackValues;
+
+  LabeledVertex(const BFS<T> &p_bfs, int p_numOwn, int p_numOther)
+    : m_basic((p_numOwn + c_bitsPerWord - 1) / c_bitsPerWord, 0),
+      m_slack((p_numOther + c_bitsPerWord - 1) / c_bitsPerWord, 0),
+      m_values(p_numOwn), m_slackValues(p_numOther)
+  {
+    for (typename BFS<T>::const_iterator iter = p_bfs.begin();
+	 iter != p_bfs.end(); ++iter) {
+      int k = iter->first;
+      if (k >= 1 && k <= p_numOwn) {
+	m_basic[(k-1) / c_bitsPerWord] |= 1UL << ((k-1) % c_bitsPerWord);
+	m_values[k] = iter->second;
+      }
+      else if (k <= -1 && -k <= p_numOther) {
+	m_slack[(-k-1) / c_bitsPerWord] |= 1UL << ((-k-1) % c_bitsPerWord);
+	m_slackValues[-k] = iter->second;
+      }
+    }
+  }
+
+  bool IsBasic(int k) const
+  { return (m_basic[(k-1) / c_bitsPerWord] >> ((k-1) % c_bitsPerWord)) & 1UL; }
+};
+
+//
+// Returns true if, for every strategy at which p_vertex has a basic
+// coordinate and p_other has a basic slack, one of the two is zero.
+// Only labels shared between the two bitsets are examined.
+//
+template <class T> bool 
+IsComplementary(const LabeledVertex<T> &p_vertex, const LabeledVertex<T> &p_other,
+		bool (*p_eqZero)(const T &))
+{
+  for (size_t w = 0; w < p_vertex.m_basic.size(); w++) {
+    unsigned long common = p_vertex.m_basic[w] & p_other.m_slack[w];
+    for (int bit = 0; common != 0; bit++, common >>= 1) {
+      if (common & 1UL) {
+	int k = w * c_bitsPerWord + bit + 1;
+	if (!p_eqZero(p_vertex.m_values[k] * p_other.m_slackValues[k])) {
+	  return false;
+	}
+      }
+    }
+  }
+  return true;
+}
+
+//
+// Finds, for each vertex of the second polytope, the vertices of the
+// first polytope complementary to it.  Each call handles one vertex of
+// the second polytope, so calls for different vertices may run
+// concurrently.
+//
+template <class T> class MatchTask {
+public:
+  MatchTask(const std::vector<LabeledVertex<T> > &p_vertices1,
+	    const std::vector<LabeledVertex<T> > &p_vertices2,
+	    bool (*p_eqZero)(const T &))
+    : m_vertices1(p_vertices1), m_vertices2(p_vertices2),
+      m_eqZero(p_eqZero), m_matches(p_vertices2.size() + 1) { }
+
+  void operator()(int i)
+  {
+    // Vertex indices are offset by one, as the origin is skipped
+    int i2 = i + 1;
+    const LabeledVertex<T> &vertex2 = m_vertices2[i2-1];
+    for (size_t i1 = 2; i1 <= m_vertices1.size(); i1++) {
+      const LabeledVertex<T> &vertex1 = m_vertices1[i1-1];
+      if (IsComplementary(vertex2, vertex1, m_eqZero) &&
+	  IsComplementary(vertex1, vertex2, m_eqZero)) {
+	m_matches[i2].push_back(i1);
+      }
+    }
+  }
+
+  const std::vector<int> &GetMatches(int i2) const { return m_matches[i2]; }
+
+private:
+  const std::vector<LabeledVertex<T> > &m_vertices1, &m_vertices2;
+  bool (*m_eqZero)(const T &);
+  std::vector<std::vector<int> > m_matches;
+};
+
+//
+// Collects the vertices found by a VertexEnumerator, in the order found.
+//
+template <class T> class VertexIndex : public VertexVisitor<T> {
+public:
+  VertexIndex(int p_numOwn, int p_numOther)
+    : m_numOwn(p_numOwn), m_numOther(p_numOther) { }
+  virtual ~VertexIndex() { }
+
+  virtual void Visit(const BFS<T> &p_vertex)
+  { m_vertices.push_back(LabeledVertex<T>(p_vertex, m_numOwn, m_numOther)); }
+
+  const std::vector<LabeledVertex<T> > &GetVertices(void) const
+  { return m_vertices; }
+
+private:
+  int m_numOwn, m_numOther;
+  std::vector<LabeledVertex<T> > m_vertices;
+};
+
+}  // end anonymous namespace
+
+//
+// Records the equilibrium given by a complementary pair of vertices,
+// the i1'th of the first polytope and the i2'th of the second, and
+// assigns ids to the vertices the first time they appear in an
+// equilibrium, for use in computing connectedness.
+//
+template <class T> class EnumMixedStrategySolver<T>::Recorder {
+public:
+  Recorder(const EnumMixedStrategySolver<T> &p_solver, const Game &p_game,
+	   EnumMixedStrategySolution<T> &p_solution)
+    : m_solver(p_solver), m_game(p_game), m_solution(p_solution),
+      m_id1(0), m_id2(0) { }
+
+  void Record(int i1, const LabeledVertex<T> &p_vertex1,
+	      int i2, const LabeledVertex<T> &p_vertex2);
+
+private:
+  const EnumMixedStrategySolver<T> &m_solver;
+  const Game &m_game;
+  EnumMixedStrategySolution<T> &m_solution;
+  std::vector<int> m_vert1id, m_vert2id;
+  int m_id1, m_id2;
+};
+
+template <class T> void
+EnumMixedStrategySolver<T>::Recorder::Record(int i1, const LabeledVertex<T> &p_vertex1,
+					     int i2, const LabeledVertex<T> &p_vertex2)
+{
+  int n1 = m_game->Players()[1]->Strategies().size();
+  int n2 = m_game->Players()[2]->Strategies().size();
+
+  MixedStrategyProfile<T> profile(m_game->NewMixedStrategyProfile(static_cast<T>(0)));
+  static_cast<Vector<T> &>(profile) = static_cast<T>(0);
+  for (int k = 1; k <= n1; k++) {
+    if (p_vertex2.IsBasic(k)) {
+      profile[m_game->Players()[1]->Strategies()[k]] = -p_vertex2.m_values[k];
+    }
+  } 
+  for (int k = 1; k <= n2; k++) {
+    if (p_vertex1.IsBasic(k)) {
+      profile[m_game->Players()[2]->Strategies()[k]] = -p_vertex1.m_values[k];
+    }
+  } 
+  profile.Normalize();
+  m_solution.m_extremeEquilibria.push_back(profile);
+  m_solver.m_onEquilibrium->Render(profile);
+
+  // note: The keys give the mixed strategy associated with each node. 
+  //       The keys should also keep track of the basis
+  //       As things stand now, two different bases could lead to
+  //       the same key... BAD!
+  if ((int) m_vert1id.size() <= i1)  m_vert1id.resize(i1 + 1, 0);
+  if ((int) m_vert2id.size() <= i2)  m_vert2id.resize(i2 + 1, 0);
+  if (m_vert1id[i1] == 0) {
+    m_vert1id[i1] = ++m_id1;
+    m_solution.m_key2.push_back(profile[m_game->GetPlayer(2)]);
+  }
+  if (m_vert2id[i2] == 0) {
+    m_vert2id[i2] = ++m_id2;
+    m_solution.m_key1.push_back(profile[m_game->GetPlayer(1)]);
+  }
+  m_solution.m_node1.Append(m_vert2id[i2]);
+  m_solution.m_node2.Append(m_vert1id[i1]);
+}
+
+//
+// Matches each vertex of one polytope, as it is enumerated, against
+// the stored vertices of the other, and records any equilibria found.
+//
+template <class T> 
+class EnumMixedStrategySolver<T>::VertexStream : public VertexVisitor<T> {
+public:
+  VertexStream(Recorder &p_recorder, const std::vector<LabeledVertex<T> > &p_index,
+	       bool p_indexIsFirst, int p_numOwn, int p_numOther)
+    : m_recorder(p_recorder), m_index(p_index), m_indexIsFirst(p_indexIsFirst),
+      m_numOwn(p_numOwn), m_numOther(p_numOther), m_count(0) { }
+  virtual ~VertexStream() { }
+
+  virtual void Visit(const BFS<T> &p_vertex)
+  {
+    if (++m_count == 1)  return;
+    LabeledVertex<T> vertex(p_vertex, m_numOwn, m_numOther);
+    for (size_t i = 2; i <= m_index.size(); i++) {
+      const LabeledVertex<T> &other = m_index[i-1];
+      if (IsComplementary(vertex, other, &EnumMixedStrategySolver<T>::EqZero) &&
+	  IsComplementary(other, vertex, &EnumMixedStrategySolver<T>::EqZero)) {
+	if (m_indexIsFirst) {
+	  m_recorder.Record(i, other, m_count, vertex);
+	}
+	else {
+	  m_recorder.Record(m_count, vertex, i, other);
+	}
+      }
+    }
+  }
+
+  int NumVertices(void) const { return m_count; }
+
+private:
+  Recorder &m_recorder;
+  const std::vector<LabeledVertex<T> > &m_index;
+  bool m_indexIsFirst;
+  int m_numOwn, m_numOther, m_count;
+};
+
 template <class T> List<List<MixedStrategyProfile<T> > > 
 EnumMixedStrategySolution<T>::GetCliques(void) const
 {
@@ -117,80 +348,53 @@ EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
   b1 = (T) -1;
   b2 = (T) -1;
 
-  // enumerate vertices of A1 x + b1 <= 0 and A2 x + b2 <= 0
-  VertexEnumerator<T> poly1(A1, b1);
-  VertexEnumerator<T> poly2(A2, b2);
-
-  const List<BFS<T> > &verts1(poly1.VertexList());
-  const List<BFS<T> > &verts2(poly2.VertexList());
-  solution->m_v1 = verts1.Length();
-  solution->m_v2 = verts2.Length();
-
-  Array<int> vert1id(solution->m_v1);
-  Array<int> vert2id(solution->m_v2);
-  for (int i = 1; i <= vert1id.Length(); vert1id[i++] = 0);
-  for (int i = 1; i <= vert2id.Length(); vert2id[i++] = 0);
-
-  int i = 0;
-  int id1 = 0, id2 = 0;
-
-  for (int i2 = 2; i2 <= solution->m_v2; i2++) {
-    BFS<T> bfs1 = verts2[i2];
-    i++;
-    for (int i1 = 2; i1 <= solution->m_v1; i1++) {
-      BFS<T> bfs2 = verts1[i1];
-	
-      // check if solution is nash 
-      // need only check complementarity, since it is feasible
-      bool nash = true;
-      for (size_t k = 1; nash && k <= p_game->Players()[1]->Strategies().size(); k++) {
-	if (bfs1.count(k) && bfs2.count(-((signed int)k))) {
-	  nash = nash && EqZero(bfs1[k] * bfs2[-((signed int)k)]);
-	}
-      }
+  int n1 = p_game->Players()[1]->Strategies().size();
+  int n2 = p_game->Players()[2]->Strategies().size();
+  Recorder recorder(*this, p_game, *solution);
 
-      for (size_t k = 1; nash && k <= p_game->Players()[2]->Strategies().size(); k++) {
-	if (bfs2.count(k) && bfs1.count(-((signed int)k))) {
-	  nash = nash && EqZero(bfs2[k] * bfs1[-((signed int)k)]);
-	}
-      }
+  // Enumerate vertices of A1 x + b1 <= 0 and A2 x + b2 <= 0.
+  // The first vertex of each polytope is the origin, which is skipped
+  // in matching.
+  if (!m_stream) {
+    VertexIndex<T> index1(n2, n1), index2(n1, n2);
+    VertexEnumerator<T> poly1(A1, b1, index1);
+    VertexEnumerator<T> poly2(A2, b2, index2);
+    const std::vector<LabeledVertex<T> > &vertices1 = index1.GetVertices();
+    const std::vector<LabeledVertex<T> > &vertices2 = index2.GetVertices();
+    solution->m_v1 = vertices1.size();
+    solution->m_v2 = vertices2.size();
 
-      if (nash) {
-	MixedStrategyProfile<T> profile(p_game->NewMixedStrategyProfile(static_cast<T>(0)));
-	static_cast<Vector<T> &>(profile) = static_cast<T>(0);
-	for (size_t k = 1; k <= p_game->Players()[1]->Strategies().size(); k++) {
-	  if (bfs1.count(k)) {
-	    profile[p_game->Players()[1]->Strategies()[k]] = -bfs1[k];
-	  }
-	} 
-	for (size_t k = 1; k <= p_game->Players()[2]->Strategies().size(); k++) {
-	  if (bfs2.count(k)) {
-	    profile[p_game->Players()[2]->Strategies()[k]] = -bfs2[k];
-	  }
-	} 
-	profile.Normalize();
-	solution->m_extremeEquilibria.push_back(profile);
-	this->m_onEquilibrium->Render(profile);
-	  
-	// note: The keys give the mixed strategy associated with each node. 
-	//       The keys should also keep track of the basis
-	//       As things stand now, two different bases could lead to
-	//       the same key... BAD!
-	if (vert1id[i1] == 0) {
-	  id1++;
-	  vert1id[i1] = id1;
-	  solution->m_key2.push_back(profile[p_game->GetPlayer(2)]);
-	}
-	if (vert2id[i2] == 0) {
-	  id2++;
-	  vert2id[i2] = id2;
-	  solution->m_key1.push_back(profile[p_game->GetPlayer(1)]);
-	}
-	solution->m_node1.Append(vert2id[i2]);
-	solution->m_node2.Append(vert1id[i1]);
+    // Find the complementary pairs first, possibly concurrently; the
+    // equilibria are then reported in the same order as a sequential scan.
+    MatchTask<T> matcher(vertices1, vertices2, &EnumMixedStrategySolver<T>::EqZero);
+    if (solution->m_v2 >= 2) {
+      ParallelFor(solution->m_v2 - 1, m_numThreads, matcher);
+    }
+    for (int i2 = 2; i2 <= solution->m_v2; i2++) {
+      const std::vector<int> &matches = matcher.GetMatches(i2);
+      for (size_t m = 0; m < matches.size(); m++) {
+	recorder.Record(matches[m], vertices1[matches[m]-1], i2, vertices2[i2-1]);
       }
     }
   }
+  else if (n2 <= n1) {
+    // The first polytope, which lies in the space of the second player's
+    // strategies, is the smaller one to keep
+    VertexIndex<T> index1(n2, n1);
+    VertexEnumerator<T> poly1(A1, b1, index1);
+    VertexStream stream(recorder, index1.GetVertices(), true, n1, n2);
+    VertexEnumerator<T> poly2(A2, b2, stream);
+    solution->m_v1 = index1.GetVertices().size();
+    solution->m_v2 = stream.NumVertices();
+  }
+  else {
+    VertexIndex<T> index2(n1, n2);
+    VertexEnumerator<T> poly2(A2, b2, index2);
+    VertexStream stream(recorder, index2.GetVertices(), false, n2, n1);
+    VertexEnumerator<T> poly1(A1, b1, stream);
+    solution->m_v1 = stream.NumVertices();
+    solution->m_v2 = index2.GetVertices().size();
+  }
   return solution;
 }
 
@@ -44,67 +44,59 @@ typedef enum {
 //!
 //! This parser class implements the semantics of Gambit savefiles,
 //! including the nonsignificance of whitespace and the possibility of
-//! escaped-quotes within text labels.
+//! escaped-quotes within text labels.  Tokens are scanned directly
+//! from a buffer holding the whole file.
 //!
 class GameParserState {
 private:
-  std::istream &m_file;
-
+  const char *m_current, *m_end, *m_lineStart;
   int m_currentLine;
-  int m_currentColumn;
   GameFileToken m_lastToken;
   std::string m_lastText;
 
-  void ReadChar(char& c);
-  void UnreadChar(void);
-  void IncreaseLine(void);
+  void SkipDigits(void)
+  { while (m_current != m_end && isdigit((unsigned char) *m_current)) m_current++; }
+  void SkipExponent(void);
 
 public:
-  GameParserState(std::istream &p_file) :
-    m_file(p_file), m_currentLine(1), m_currentColumn(1) { }
+  GameParserState(const char *p_begin, const char *p_end) :
+    m_current(p_begin), m_end(p_end), m_lineStart(p_begin),
+    m_currentLine(1), m_lastToken(TOKEN_EOF) { }
 
   GameFileToken GetNextToken(void);
   GameFileToken GetCurrentToken(void) const { return m_lastToken; }
   int GetCurrentLine(void) const { return m_currentLine; }
-  int GetCurrentColumn(void) const { return m_currentColumn; }
+  int GetCurrentColumn(void) const { return (int) (m_current - m_lineStart) + 1; }
   std::string CreateLineMsg(const std::string &msg);
   const std::string &GetLastText(void) const { return m_lastText; }
+  /// Returns the position just after the last token read
+  const char *GetPosition(void) const { return m_current; }
 };
 
-void GameParserState::ReadChar(char& c)
-{
-  m_file.get(c);
-  m_currentColumn++;
-}
-
-void GameParserState::UnreadChar(void)
+void GameParserState::SkipExponent(void)
 {
-  m_file.unget();
-  m_currentColumn--;
-}
-
-void GameParserState::IncreaseLine(void){
-  m_currentLine++;
-  // Reset column
-  m_currentColumn = 1;
+  // Skip the 'e' or 'E', and the sign of the exponent if present
+  m_current++;
+  if (m_current != m_end && (*m_current == '+' || *m_current == '-')) {
+    m_current++;
+  }
+  SkipDigits();
 }
 
 GameFileToken GameParserState::GetNextToken(void)
 {
-  char c = ' ';
-  if (m_file.eof()) {
+  while (m_current != m_end && isspace((unsigned char) *m_current)) {
+    if (*m_current++ == '\n') {
+      m_currentLine++;
+      m_lineStart = m_current;
+    }
+  }
+  if (m_current == m_end) {
     return (m_lastToken = TOKEN_EOF);
   }
 
-  while (isspace(c)) {
-    ReadChar(c);
-    if (!m_file.good()) {
-      return (m_lastToken = TOKEN_EOF);
-    }
-    else if (c == '\n') {
-      IncreaseLine();
-    }
-  }
+  const char *start = m_current;
+  char c = *m_current++;
 
   if (c == '{') {
     return (m_lastToken = TOKEN_LBRACE);
@@ -115,163 +107,100 @@ GameFileToken GameParserState::GetNextToken(void)
   else if (c == ',') {
     return (m_lastToken = TOKEN_COMMA);
   }
-  else if (isdigit(c) || c == '-' || c == '+') {
-    std::string buf;
-    buf += c;
-    ReadChar(c);
-
-    while (!m_file.eof() && m_file.good() && isdigit(c)) {
-      buf += c;
-      ReadChar(c);
-    }
-
-    if (m_file.eof() || !m_file.good()) {
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
-    }
-
-    if (c == '.') {
-      buf += c;
-      ReadChar(c);
-      while (isdigit(c)) {
-        buf += c;
-        ReadChar(c);
-      }
-
-      if (c == 'e' || c == 'E') {
-        buf += c;
-        ReadChar(c);
-        if (c == '+' && c == '-' && !isdigit(c)) {
-          throw InvalidFileException(CreateLineMsg("Invalid Token +/-"));
-        }
-        buf += c;
-        ReadChar(c);
-        while (isdigit(c)) {
-          buf += c;
-          ReadChar(c);
-        }
-      }
-
-      UnreadChar();
-      m_lastText = buf;
-
-      return (m_lastToken = TOKEN_NUMBER);
-    }
-    else if (c == '/') {
-      buf += c;
-      ReadChar(c);
-      while (isdigit(c)) {
-        buf += c;
-        ReadChar(c);
+  else if (isdigit((unsigned char) c) || c == '-' || c == '+') {
+    SkipDigits();
+    if (m_current != m_end) {
+      if (*m_current == '.') {
+	m_current++;
+	SkipDigits();
+	if (m_current != m_end && (*m_current == 'e' || *m_current == 'E')) {
+	  SkipExponent();
+	}
       }
-      UnreadChar();
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
-    }
-    else if (c == 'e' || c == 'E') {
-      buf += c;
-      ReadChar(c);
-      if (c == '+' && c == '-' && !isdigit(c)) {
-        throw InvalidFileException(CreateLineMsg("Invalid Token +/-"));
+      else if (*m_current == '/') {
+	m_current++;
+	SkipDigits();
       }
-      buf += c;
-      ReadChar(c);
-      while (isdigit(c)) {
-        buf += c;
-        ReadChar(c);
+      else if (*m_current == 'e' || *m_current == 'E') {
+	SkipExponent();
       }
-      UnreadChar();
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
-    }
-    else {
-      UnreadChar();
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
     }
+    m_lastText.assign(start, m_current);
+    return (m_lastToken = TOKEN_NUMBER);
   }
   else if (c == '.') {
-    std::string buf;
-    buf += c;
-    ReadChar(c);
-
-    while (isdigit(c)) {
-      buf += c;
-      ReadChar(c);
-    }
-    UnreadChar();
-    m_lastText = buf;
+    SkipDigits();
+    m_lastText.assign(start, m_current);
     return (m_lastToken = TOKEN_NUMBER);
   }
-
   else if (c == '"') {
+    // Labels without backslashes can be taken as they stand
+    const char *close = m_current;
+    while (close != m_end && *close != '"' && *close != '\\')  close++;
+    if (close != m_end && *close == '"') {
+      m_lastText.assign(m_current, close);
+      m_current = close + 1;
+      return (m_lastToken = TOKEN_TEXT);
+    }
+
     // We need to do a little magic here, since escaped quotes inside
     // the string are treated as quotes (not end-of-string)
-    UnreadChar();
-    char a;
-
-    m_lastText = "";
-
-    do  {
-      ReadChar(a);
-      if (a == '\n') {
-        IncreaseLine();
+    m_lastText.clear();
+    bool lastslash = false;
+    while (m_current != m_end && (*m_current != '"' || lastslash)) {
+      char a = *m_current++;
+      if (lastslash && a == '"') {
+	m_lastText += '"';
       }
-    } while (isspace(a));
-
-    if (a == '\"')  {
-      bool lastslash = false;
-
-      ReadChar(a);
-      while  (a != '\"' || lastslash)  {
-	if (m_file.eof() || !m_file.good())  {
-	  throw InvalidFileException(CreateLineMsg("End of file encountered when reading string label"));
-	}
-        if (lastslash && a == '"') {
-          m_lastText += '"';
-	}
-        else if (lastslash)  {
-          m_lastText += '\\';
-          m_lastText += a;
-        }
-        else if (a != '\\')
-          m_lastText += a;
-
-        lastslash = (a == '\\');
-        ReadChar(a);
+      else if (lastslash) {
+	m_lastText += '\\';
+	m_lastText += a;
+      }
+      else if (a != '\\') {
+	m_lastText += a;
       }
+      lastslash = (a == '\\');
     }
-    else  {
-      do  {
-      	m_lastText += a;
-        ReadChar(a);
-	if (m_file.eof() || !m_file.good())  {
-	  throw InvalidFileException(CreateLineMsg("End of file encountered when reading string label"));
-	}
-        if (a == '\n') {
-          IncreaseLine();
-        }
-      }  while (!isspace(a));
+    if (m_current == m_end) {
+      throw InvalidFileException(CreateLineMsg("End of file encountered when reading string label"));
     }
-
+    m_current++;
     return (m_lastToken = TOKEN_TEXT);
   }
 
-  m_lastText = "";
-  while (!isspace(c) && !m_file.eof()) {
-    m_lastText += c;
-    ReadChar(c);
+  while (m_current != m_end && !isspace((unsigned char) *m_current)) {
+    m_current++;
   }
+  m_lastText.assign(start, m_current);
   return (m_lastToken = TOKEN_SYMBOL);
 }
 
 std::string GameParserState::CreateLineMsg(const std::string &msg)
 {
   std::stringstream stream;
-  stream << "line " << m_currentLine << ":" << m_currentColumn << ": " << msg;
+  stream << "line " << m_currentLine << ":" << GetCurrentColumn() << ": " << msg;
   return stream.str();
 }
 
+/// Reads the remainder of p_file into p_contents, in large blocks
+void ReadContents(std::istream &p_file, std::string &p_contents)
+{
+  std::streampos start = p_file.tellg();
+  if (start != std::streampos(-1) && p_file.seekg(0, std::ios::end)) {
+    std::streampos end = p_file.tellg();
+    p_file.seekg(start);
+    if (end > start) {
+      p_contents.reserve((size_t) (end - start));
+    }
+  }
+  p_file.clear();
+
+  char block[65536];
+  while (p_file.read(block, sizeof(block)) || p_file.gcount() > 0) {
+    p_contents.append(block, (size_t) p_file.gcount());
+  }
+}
+
 class TableFilePlayer {
 public:
   std::string m_name;
@@ -605,19 +534,25 @@ void ParseOutcomeBody(GameParserState &p_parser, GameRep *p_nfg)
 
 void ParsePayoffBody(GameParserState &p_parser, GameRep *p_nfg)
 {
-  StrategyProfileIterator iter(StrategySupportProfile(static_cast<GameRep *>(p_nfg)));
-  int pl = 1;
+  // The table has just been created with one outcome per contingency,
+  // numbered in the order in which contingencies are listed in the file.
+  // As with iterating over the profiles, payoffs beyond the last
+  // contingency start over at the first.
+  int numPlayers = p_nfg->NumPlayers(), numOutcomes = p_nfg->NumOutcomes();
+  int cont = 1, pl = 1;
+  GameOutcomeRep *outcome = p_nfg->GetOutcome(cont);
 
   while (p_parser.GetCurrentToken() != TOKEN_EOF) {
     if (p_parser.GetCurrentToken() == TOKEN_NUMBER) {
-      (*iter)->GetOutcome()->SetPayoff(pl, p_parser.GetLastText());
+      outcome->SetPayoff(pl, p_parser.GetLastText());
     }
     else {
       throw InvalidFileException(p_parser.CreateLineMsg("Expecting payoff"));
     }
 
-    if (++pl > p_nfg->NumPlayers()) {
-      iter++;
+    if (++pl > numPlayers) {
+      if (++cont > numOutcomes)  cont = 1;
+      outcome = p_nfg->GetOutcome(cont);
       pl = 1;
     }
     p_parser.GetNextToken();
@@ -1053,17 +988,24 @@ Game GameXMLSavefile::GetGame(void) const
 
 Game ReadGame(std::istream &p_file) throw (InvalidFileException)
 {
-  std::stringstream buffer;
-  buffer << p_file.rdbuf();
-  try {
-    GameXMLSavefile doc(buffer.str());
+  std::string contents;
+  ReadContents(p_file, contents);
+  const char *begin = contents.data(), *end = begin + contents.size();
+
+  // The format is determined from the start of the file: binary
+  // savefiles begin with their signature, and XML documents are the
+  // only text files starting with '<'
+  if (IsBinaryGame(begin, contents.size())) {
+    return ReadBinaryGame(begin, contents.size());
+  }
+  const char *first = begin;
+  while (first != end && isspace((unsigned char) *first))  first++;
+  if (first != end && *first == '<') {
+    GameXMLSavefile doc(contents);
     return doc.GetGame();
   }
-  catch (InvalidFileException) {
-    buffer.seekg(0, std::ios::beg);
-  }
 
-  GameParserState parser(buffer);
+  GameParserState parser(begin, end);
   try {
     if (parser.GetNextToken() != TOKEN_SYMBOL) {
       throw InvalidFileException(parser.CreateLineMsg("Expecting file type"));
@@ -1083,10 +1025,12 @@ Game ReadGame(std::istream &p_file) throw (InvalidFileException)
       return game;
     }
     else if (parser.GetLastText() == "#AGG") {
-      return GameAggRep::ReadAggFile(buffer);
+      std::istringstream rest(std::string(parser.GetPosition(), end));
+      return GameAggRep::ReadAggFile(rest);
     }
     else if (parser.GetLastText() == "#BAGG") {
-      return GameBagentRep::ReadBaggFile(buffer);
+      std::istringstream rest(std::string(parser.GetPosition(), end));
+      return GameBagentRep::ReadBaggFile(rest);
     }
     else {
       throw InvalidFileException("Tokens 'EFG' or 'NFG' or '#AGG' or '#BAGG' expected at start of file");
@@ -26,6 +26,7 @@
 #include "gambit/gambit.h"
 #include "gambit/gametree.h"
 #include "gambit/gametable.h"
+#include "gambit/outbuf.h"
 
 namespace Gambit {
 
@@ -404,23 +405,6 @@ PureBehaviorProfile::ToMixedBehaviorProfile(void) const
 //                     GameRep: Writing data files
 //------------------------------------------------------------------------
 
-  
-namespace {
-
-std::string EscapeQuotes(const std::string &s)
-{
-  std::string ret;
-  
-  for (unsigned int i = 0; i < s.length(); i++)  {
-    if (s[i] == '"')   ret += '\\';
-    ret += s[i];
-  }
-
-  return ret;
-}
-
-}  // end anonymous namespace
-
 ///
 /// Write the game to a savefile in .nfg payoff format.
 ///
@@ -434,34 +418,105 @@ std::string EscapeQuotes(const std::string &s)
 ///
 void GameRep::WriteNfgFile(std::ostream &p_file) const
 { 
-  p_file << "NFG 1 R";
-  p_file << " \"" << EscapeQuotes(GetTitle()) << "\" { ";
+  OutputBuffer out(p_file);
+  out << "NFG 1 R ";
+  out.Quoted(GetTitle()) << " { ";
   for (int i = 1; i <= NumPlayers(); i++)
-    p_file << '"' << EscapeQuotes(GetPlayer(i)->GetLabel()) << "\" ";
+    out.Quoted(GetPlayer(i)->GetLabel()) << ' ';
 
-  p_file << "}\n\n{ ";
+  out << "}\n\n{ ";
   
   for (int i = 1; i <= NumPlayers(); i++)   {
     GamePlayerRep *player = GetPlayer(i);
-    p_file << "{ ";
+    out << "{ ";
     for (int j = 1; j <= player->NumStrategies(); j++)
-      p_file << '"' << EscapeQuotes(player->GetStrategy(j)->GetLabel()) << "\" ";
-    p_file << "}\n";
+      out.Quoted(player->GetStrategy(j)->GetLabel()) << ' ';
+    out << "}\n";
   }
-  p_file << "}\n";
-  p_file << "\"" << EscapeQuotes(m_comment) << "\"\n\n";
+  out << "}\n";
+  out.Quoted(m_comment) << "\n\n";
 
   for (StrategyProfileIterator iter(Game(const_cast<GameRep *>(this)));
        !iter.AtEnd(); iter++) {
     for (int pl = 1; pl <= NumPlayers(); pl++) {
-      p_file << (*iter)->GetPayoff(pl) << " ";
+      out << (*iter)->GetPayoff(pl) << ' ';
     }
-    p_file << "\n";
+    out << '\n';
   }
-  p_file << '\n';
+  out << '\n';
 }
 
 
+//------------------------------------------------------------------------
+//                   GameRep: Sharing between threads
+//------------------------------------------------------------------------
+
+void GameRep::Freeze(void)
+{
+  if (m_frozen)  return;
+
+  // Build everything which would otherwise be computed lazily when
+  // the game is first read, as reads may then happen concurrently.
+  Canonicalize();
+  BuildComputedValues();
+  BuildPayoffCache();
+
+  // Handles are released before the objects they refer to are frozen,
+  // so that the reference counts are left balanced.
+  for (int pl = 1; pl <= NumPlayers(); pl++) {
+    GamePlayerRep *player = GetPlayer(pl);
+    for (int st = 1; st <= player->NumStrategies(); st++) {
+      GameStrategyRep *strategy = player->GetStrategy(st);
+      strategy->m_frozen = true;
+    }
+  }
+
+  if (IsTree()) {
+    Array<GamePlayerRep *> players;
+    for (int pl = 1; pl <= NumPlayers(); pl++) {
+      players.Append(GetPlayer(pl));
+    }
+    players.Append(GetChance());
+    for (int pl = 1; pl <= players.Length(); pl++) {
+      for (int iset = 1; iset <= players[pl]->NumInfosets(); iset++) {
+	GameInfosetRep *infoset = players[pl]->GetInfoset(iset);
+	for (int act = 1; act <= infoset->NumActions(); act++) {
+	  GameActionRep *action = infoset->GetAction(act);
+	  action->m_frozen = true;
+	}
+	infoset->m_frozen = true;
+      }
+      players[pl]->m_frozen = true;
+    }
+
+    Array<GameNodeRep *> nodes;
+    nodes.Append(GetRoot());
+    while (nodes.Length() > 0) {
+      GameNodeRep *node = nodes.Remove(nodes.Length());
+      for (int i = 1; i <= node->NumChildren(); i++) {
+	nodes.Append(node->GetChild(i));
+      }
+      node->m_frozen = true;
+    }
+  }
+  else {
+    for (int pl = 1; pl <= NumPlayers(); pl++) {
+      GamePlayerRep *player = GetPlayer(pl);
+      player->m_frozen = true;
+    }
+  }
+
+  // Action-graph games have no outcome objects.
+  if (!IsAgg() && !IsBagg()) {
+    for (int outc = 1; outc <= NumOutcomes(); outc++) {
+      GameOutcomeRep *outcome = GetOutcome(outc);
+      outcome->m_frozen = true;
+    }
+  }
+
+  m_frozen = true;
+}
+
 //========================================================================
 //                       class GameExplicitRep
 //========================================================================
@@ -602,6 +657,9 @@ void GameExplicitRep::Write(std::ostream &p_stream,
 	   (p_format == "native" && !IsTree())) {
     WriteNfgFile(p_stream);
   }
+  else if (p_format == "binary") {
+    WriteBinaryFile(p_stream);
+  }
   else {
     throw UndefinedException();
   }
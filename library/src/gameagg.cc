@@ -21,7 +21,6 @@
 //
 
 #include <iostream>
-#include <sstream>
 
 #include "gambit/gambit.h"
 #include "gambit/gameagg.h"
@@ -105,10 +104,17 @@ GameAggRep::GameAggRep(agg::AGG *p_aggPtr)
 
 Game GameAggRep::Copy(void) const
 {
-  std::ostringstream os;
-  WriteAggFile(os);
-  std::istringstream is(os.str());
-  return ReadAggFile(is);
+  GameAggRep *copy = new GameAggRep(new agg::AGG(*aggPtr));
+  Game game = copy;
+  copy->SetTitle(GetTitle());
+  copy->SetComment(GetComment());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    copy->m_players[pl]->m_label = m_players[pl]->m_label;
+    for (int st = 1; st <= m_players[pl]->m_strategies.Length(); st++) {
+      copy->m_players[pl]->m_strategies[st]->SetLabel(m_players[pl]->m_strategies[st]->GetLabel());
+    }
+  }
+  return game;
 }
 
 //------------------------------------------------------------------------
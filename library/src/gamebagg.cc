@@ -21,7 +21,6 @@
 //
 
 #include <iostream>
-#include <sstream>
 
 #include "gambit/gambit.h"
 #include "gambit/gamebagg.h"
@@ -65,7 +64,11 @@ Rational BagentPureStrategyProfileRep::GetPayoff(int pl) const
   }
   int bp = dynamic_cast<GameBagentRep &>(*m_nfg).agent2baggPlayer[pl];
   int tp = pl - 1 - baggPtr->typeOffset[bp-1];
-  Rational ret = baggPtr->getPurePayoff(bp-1,tp,s);
+  Rational ret;
+  {
+    std::lock_guard<std::mutex> lock(dynamic_cast<GameBagentRep &>(*m_nfg).m_payoffMutex);
+    ret = baggPtr->getPurePayoff(bp-1,tp,s);
+  }
   free(s);
   return ret;
 }
@@ -82,7 +85,11 @@ BagentPureStrategyProfileRep::GetStrategyValue(const GameStrategy &p_strategy) c
   s[player-1] = p_strategy->GetNumber() - 1;
   int bp = dynamic_cast<GameBagentRep &>(*m_nfg).agent2baggPlayer[player];
   int tp = player - 1 - baggPtr->typeOffset[bp-1];
-  Rational ret = baggPtr->getPurePayoff(bp-1,tp,s);
+  Rational ret;
+  {
+    std::lock_guard<std::mutex> lock(dynamic_cast<GameBagentRep &>(*m_nfg).m_payoffMutex);
+    ret = baggPtr->getPurePayoff(bp-1,tp,s);
+  }
   free(s);
   return ret;
 }
@@ -115,10 +122,17 @@ GameBagentRep::GameBagentRep(agg::BAGG *_baggPtr)
 
 Game GameBagentRep::Copy(void) const
 {
-  std::ostringstream os;
-  WriteBaggFile(os);
-  std::istringstream is(os.str());
-  return ReadBaggFile(is);
+  GameBagentRep *copy = new GameBagentRep(new agg::BAGG(*baggPtr));
+  Game game = copy;
+  copy->SetTitle(GetTitle());
+  copy->SetComment(GetComment());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    copy->m_players[pl]->m_label = m_players[pl]->m_label;
+    for (int st = 1; st <= m_players[pl]->m_strategies.Length(); st++) {
+      copy->m_players[pl]->m_strategies[st]->SetLabel(m_players[pl]->m_strategies[st]->GetLabel());
+    }
+  }
+  return game;
 }
 
 //------------------------------------------------------------------------
@@ -25,6 +25,7 @@
 
 #include "gambit/gambit.h"
 #include "gambit/gametable.h"
+#include "gambit/outbuf.h"
 
 namespace Gambit {
 
@@ -87,7 +88,9 @@ GameOutcome TablePureStrategyProfileRep::GetOutcome(void) const
 
 void TablePureStrategyProfileRep::SetOutcome(GameOutcome p_outcome)
 {
-  dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index] = p_outcome; 
+  GameTableRep &game = dynamic_cast<GameTableRep &>(*m_nfg);
+  game.m_results[m_index] = p_outcome;
+  game.ClearPayoffCache();
 }
 
 Rational TablePureStrategyProfileRep::GetPayoff(int pl) const
@@ -166,10 +169,30 @@ GameTableRep::GameTableRep(const Array<int> &dim,
 
 Game GameTableRep::Copy(void) const
 {
-  std::ostringstream os;
-  WriteNfgFile(os);
-  std::istringstream is(os.str());
-  return ReadGame(is);
+  GameTableRep *nfg = new GameTableRep(NumStrategies(), true);
+  Game game = nfg;
+  nfg->SetTitle(GetTitle());
+  nfg->SetComment(GetComment());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = nfg->m_players[pl];
+    player->m_label = m_players[pl]->m_label;
+    for (int st = 1; st <= player->m_strategies.Length(); st++) {
+      player->m_strategies[st]->m_label = m_players[pl]->m_strategies[st]->m_label;
+    }
+  }
+
+  nfg->m_outcomes = Array<GameOutcomeRep *>(m_outcomes.Length());
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    GameOutcomeRep *outcome = new GameOutcomeRep(nfg, outc);
+    outcome->m_label = m_outcomes[outc]->m_label;
+    outcome->m_payoffs = m_outcomes[outc]->m_payoffs;
+    nfg->m_outcomes[outc] = outcome;
+  }
+  for (int cont = 1; cont <= m_results.Length(); cont++) {
+    nfg->m_results[cont] = (m_results[cont]) ?
+      nfg->m_outcomes[m_results[cont]->m_number] : 0;
+  }
+  return game;
 }
 
 //------------------------------------------------------------------------
@@ -204,22 +227,6 @@ bool GameTableRep::IsConstSum(void) const
 //                   GameTableRep: Writing data files
 //------------------------------------------------------------------------
 
-namespace {
-
-std::string EscapeQuotes(const std::string &s)
-{
-  std::string ret;
-  
-  for (unsigned int i = 0; i < s.length(); i++)  {
-    if (s[i] == '"')   ret += '\\';
-    ret += s[i];
-  }
-
-  return ret;
-}
-
-}  // end anonymous namespace
-
 ///
 /// Write the game to a savefile in .nfg outcome format.
 ///
@@ -231,57 +238,49 @@ std::string EscapeQuotes(const std::string &s)
 ///  
 void GameTableRep::WriteNfgFile(std::ostream &p_file) const
 { 
-  p_file << "NFG 1 R";
-  p_file << " \"" << EscapeQuotes(GetTitle()) << "\" { ";
+  OutputBuffer out(p_file);
+  out << "NFG 1 R ";
+  out.Quoted(GetTitle()) << " { ";
 
   for (int i = 1; i <= NumPlayers(); i++)
-    p_file << '"' << EscapeQuotes(GetPlayer(i)->GetLabel()) << "\" ";
+    out.Quoted(GetPlayer(i)->GetLabel()) << ' ';
 
-  p_file << "}\n\n{ ";
+  out << "}\n\n{ ";
   
   for (int i = 1; i <= NumPlayers(); i++)   {
     GamePlayerRep *player = GetPlayer(i);
-    p_file << "{ ";
+    out << "{ ";
     for (int j = 1; j <= player->NumStrategies(); j++)
-      p_file << '"' << EscapeQuotes(player->GetStrategy(j)->GetLabel()) << "\" ";
-    p_file << "}\n";
+      out.Quoted(player->GetStrategy(j)->GetLabel()) << ' ';
+    out << "}\n";
   }
   
-  p_file << "}\n";
-
-  p_file << "\"" << EscapeQuotes(m_comment) << "\"\n\n";
+  out << "}\n";
 
-  int ncont = 1;
-  for (int i = 1; i <= NumPlayers(); i++) {
-    ncont *= m_players[i]->m_strategies.Length();
-  }
+  out.Quoted(m_comment) << "\n\n";
 
-  p_file << "{\n";
+  out << "{\n";
   for (int outc = 1; outc <= m_outcomes.Length(); outc++)   {
-    p_file << "{ \"" << EscapeQuotes(m_outcomes[outc]->m_label) << "\" ";
+    out << "{ ";
+    out.Quoted(m_outcomes[outc]->m_label) << ' ';
     for (int pl = 1; pl <= m_players.Length(); pl++)  {
-      p_file << (const std::string &) m_outcomes[outc]->m_payoffs[pl];
+      out << (const std::string &) m_outcomes[outc]->m_payoffs[pl];
       
       if (pl < m_players.Length()) {
-	p_file << ", ";
+	out << ", ";
       }
       else {
-	p_file << " }\n";
+	out << " }\n";
       }
     }
   }
-  p_file << "}\n";
+  out << "}\n";
   
-  for (int cont = 1; cont <= ncont; cont++)  {
-    if (m_results[cont] != 0) {
-      p_file << m_results[cont]->m_number << ' ';
-    }
-    else {
-      p_file << "0 ";
-    }
+  for (int cont = 1; cont <= m_results.Length(); cont++)  {
+    out << ((m_results[cont]) ? m_results[cont]->m_number : 0) << ' ';
   }
 
-  p_file << '\n';
+  out << '\n';
 }
 
 //------------------------------------------------------------------------
@@ -297,6 +296,7 @@ GamePlayer GameTableRep::NewPlayer(void)
     m_outcomes[outc]->m_payoffs.Append(Number());
   }
   ClearComputedValues();
+  ClearPayoffCache();
   return player;
 }
 
@@ -316,6 +316,62 @@ void GameTableRep::DeleteOutcome(const GameOutcome &p_outcome)
     m_outcomes[outc]->m_number = outc;
   }
   ClearComputedValues();
+  ClearPayoffCache();
+}
+
+//------------------------------------------------------------------------
+//                  GameTableRep: Compiled payoff tables
+//------------------------------------------------------------------------
+
+/// Fills p_table with one plane of payoffs per player.  Each plane
+/// has one entry per contingency, at the position given by the sum of
+/// the offsets of the strategies in the contingency, so that it can be
+/// traversed with the same strides as the table of outcomes.
+template <class T>
+void GameTableRep::BuildPayoffTable(std::vector<T> &p_table) const
+{
+  long ncont = m_results.Length();
+  p_table.assign(ncont * m_players.Length(), T(0));
+  for (long cont = 1; cont <= ncont; cont++) {
+    GameOutcomeRep *outcome = m_results[cont];
+    if (outcome) {
+      for (int pl = 1; pl <= m_players.Length(); pl++) {
+	p_table[(pl - 1) * ncont + cont - 1] = outcome->GetPayoff<T>(pl);
+      }
+    }
+  }
+}
+
+const double *GameTableRep::GetPayoffTable(int pl, double) const
+{
+  if (m_doublePayoffs.empty()) {
+    BuildPayoffTable(m_doublePayoffs);
+  }
+  return &m_doublePayoffs[(pl - 1) * m_results.Length()];
+}
+
+const Rational *GameTableRep::GetPayoffTable(int pl, const Rational &) const
+{
+  if (m_rationalPayoffs.empty()) {
+    BuildPayoffTable(m_rationalPayoffs);
+  }
+  return &m_rationalPayoffs[(pl - 1) * m_results.Length()];
+}
+
+void GameTableRep::ClearPayoffCache(void) const
+{
+  m_doublePayoffs.clear();
+  m_rationalPayoffs.clear();
+}
+
+void GameTableRep::BuildPayoffCache(void) const
+{
+  if (m_doublePayoffs.empty()) {
+    BuildPayoffTable(m_doublePayoffs);
+  }
+  if (m_rationalPayoffs.empty()) {
+    BuildPayoffTable(m_rationalPayoffs);
+  }
 }
 
 //------------------------------------------------------------------------
@@ -380,6 +436,7 @@ void GameTableRep::RebuildTable(void)
   }
 
   m_results = newResults;
+  ClearPayoffCache();
 
   IndexStrategies();
 }
@@ -21,10 +21,13 @@
 //
 
 #include <iostream>
+#include <map>
 #include <sstream>
+#include <vector>
 
 #include "gambit/gambit.h"
 #include "gambit/gametree.h"
+#include "gambit/outbuf.h"
 
 namespace Gambit {
 
@@ -435,10 +438,13 @@ void GameTreeNodeRep::MoveTree(GameNode p_src)
 
 Game GameTreeNodeRep::CopySubgame(void) const
 {
-  std::ostringstream os;
-  m_efg->WriteEfgFile(os, const_cast<GameTreeNodeRep *>(this));
-  std::istringstream is(os.str());
-  return ReadGame(is);
+  Array<Array<GameInfoset> > infosets;
+  return CopySubgame(infosets);
+}
+
+Game GameTreeNodeRep::CopySubgame(Array<Array<GameInfoset> > &p_infosets) const
+{
+  return m_efg->CopySubtree(const_cast<GameTreeNodeRep *>(this), p_infosets);
 }
 
 void GameTreeNodeRep::SetInfoset(GameInfoset p_infoset)
@@ -550,7 +556,8 @@ GameInfoset GameTreeNodeRep::InsertMove(GameInfoset p_infoset)
 //------------------------------------------------------------------------
 
 GameTreeRep::GameTreeRep(void)
-  : m_computedValues(false), m_doCanon(true)
+  : m_computedValues(false), m_doCanon(true), m_flat(0),
+    m_payoffTableBudget(64L * 1024L * 1024L)
 {
   m_chance = new GamePlayerRep(this, 0);
   m_root = new GameTreeNodeRep(this, 0);
@@ -560,14 +567,92 @@ GameTreeRep::~GameTreeRep()
 {
   m_root->Invalidate();
   m_chance->Invalidate();
+  delete m_flat;
 }
 
 Game GameTreeRep::Copy(void) const
 {
-  std::ostringstream os;
-  WriteEfgFile(os);
-  std::istringstream is(os.str());
-  return ReadGame(is);
+  Array<Array<GameInfoset> > infosets;
+  return CopySubtree(m_root, infosets);
+}
+
+//
+// Builds the copy directly, rather than by writing and reading back a
+// file.  Nodes are visited in preorder, so that outcomes and information
+// sets are created in the same order as when reading the subtree from
+// a file.  Canonicalization is deferred until the copy is complete.
+//
+Game GameTreeRep::CopySubtree(GameTreeNodeRep *p_root,
+			      Array<Array<GameInfoset> > &p_infosets) const
+{
+  GameTreeRep *efg = new GameTreeRep;
+  Game game = efg;
+  efg->m_doCanon = false;
+  efg->SetTitle(GetTitle());
+  efg->SetComment(GetComment());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    efg->NewPlayer()->SetLabel(m_players[pl]->m_label);
+  }
+
+  std::map<GameOutcomeRep *, GameOutcomeRep *> outcomes;
+  std::map<GameTreeInfosetRep *, GameTreeInfosetRep *> infosets;
+  std::vector<std::pair<GameTreeNodeRep *, GameTreeNodeRep *> > stack;
+  stack.push_back(std::make_pair(p_root, efg->m_root));
+  while (!stack.empty()) {
+    GameTreeNodeRep *src = stack.back().first, *dest = stack.back().second;
+    stack.pop_back();
+    dest->m_label = src->m_label;
+
+    if (src->outcome) {
+      GameOutcomeRep *&outcome = outcomes[src->outcome];
+      if (!outcome) {
+	outcome = new GameOutcomeRep(efg, efg->m_outcomes.Length() + 1);
+	outcome->m_label = src->outcome->m_label;
+	outcome->m_payoffs = src->outcome->m_payoffs;
+	efg->m_outcomes.Append(outcome);
+      }
+      dest->outcome = outcome;
+    }
+
+    if (src->infoset) {
+      GameTreeInfosetRep *&infoset = infosets[src->infoset];
+      if (!infoset) {
+	GamePlayerRep *player = (src->infoset->m_player->IsChance()) ?
+	  efg->m_chance : efg->m_players[src->infoset->m_player->m_number];
+	infoset = new GameTreeInfosetRep(efg, player->m_infosets.Length() + 1,
+					 player, src->infoset->m_actions.Length());
+	infoset->m_label = src->infoset->m_label;
+	for (int act = 1; act <= infoset->m_actions.Length(); act++) {
+	  infoset->m_actions[act]->m_label = src->infoset->m_actions[act]->m_label;
+	}
+	infoset->m_probs = src->infoset->m_probs;
+      }
+      dest->infoset = infoset;
+      infoset->AddMember(dest);
+      for (int i = 1; i <= src->children.Length(); i++) {
+	dest->children.Append(new GameTreeNodeRep(efg, dest));
+      }
+      for (int i = src->children.Length(); i >= 1; i--) {
+	stack.push_back(std::make_pair(src->children[i], dest->children[i]));
+      }
+    }
+  }
+
+  efg->m_doCanon = true;
+  efg->ClearComputedValues();
+  efg->Canonicalize();
+
+  p_infosets = Array<Array<GameInfoset> >(efg->m_players.Length());
+  for (int pl = 1; pl <= efg->m_players.Length(); pl++) {
+    p_infosets[pl] = Array<GameInfoset>(efg->m_players[pl]->m_infosets.Length());
+  }
+  for (std::map<GameTreeInfosetRep *, GameTreeInfosetRep *>::const_iterator
+	 infoset = infosets.begin(); infoset != infosets.end(); ++infoset) {
+    if (!infoset->second->m_player->IsChance()) {
+      p_infosets[infoset->second->m_player->m_number][infoset->second->m_number] = infoset->first;
+    }
+  }
+  return game;
 }
 
 Game NewTree(void)  { return new GameTreeRep(); }
@@ -686,6 +771,8 @@ void GameTreeRep::NumberNodes(GameTreeNodeRep *n, int &index)
 void GameTreeRep::Canonicalize(void)
 {
   if (!m_doCanon)  return;
+  ClearFlatTree();
+  ClearPayoffCache();
   int nodeindex = 1;
   NumberNodes(m_root, nodeindex);
 
@@ -742,6 +829,8 @@ void GameTreeRep::ClearComputedValues(void) const
   }
 
   m_computedValues = false;
+  ClearFlatTree();
+  ClearPayoffCache();
 }
 
 void GameTreeRep::BuildComputedValues(void)
@@ -759,131 +848,418 @@ void GameTreeRep::BuildComputedValues(void)
 	 m_players[pl]->m_strategies[st++]->m_id = id++);
   }
 
+  // Strategies are given offsets as in a table game, for indexing
+  // the payoff tables of the reduced normal form
+  long offset = 1L;
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    for (int st = 1; st <= m_players[pl]->m_strategies.Length(); st++) {
+      m_players[pl]->m_strategies[st]->m_offset = (st - 1) * offset;
+    }
+    offset *= m_players[pl]->m_strategies.Length();
+  }
+
   m_computedValues = true;
 }
 
-//------------------------------------------------------------------------
-//                  GameTreeRep: Writing data files
-//------------------------------------------------------------------------
-
-namespace {
+void GameTreeRep::ClearPayoffCache(void) const
+{
+  m_doublePayoffs.clear();
+  m_rationalPayoffs.clear();
+}
 
-std::string EscapeQuotes(const std::string &s)
+void GameTreeRep::BuildPayoffCache(void) const
 {
-  std::string ret;
-  
-  for (unsigned int i = 0; i < s.length(); i++)  {
-    if (s[i] == '"')   ret += '\\';
-    ret += s[i];
+  BuildFlatTree();
+  if (NumPayoffTableEntries<double>() > 0 && m_doublePayoffs.empty()) {
+    BuildPayoffTable(m_doublePayoffs);
   }
+  if (NumPayoffTableEntries<Rational>() > 0 && m_rationalPayoffs.empty()) {
+    BuildPayoffTable(m_rationalPayoffs);
+  }
+}
 
-  return ret;
+void GameTreeRep::ClearFlatTree(void) const
+{
+  delete m_flat;
+  m_flat = 0;
 }
 
-void PrintActions(std::ostream &p_stream, GameTreeInfosetRep *p_infoset)
-{ 
-  p_stream << "{ ";
-  for (int act = 1; act <= p_infoset->NumActions(); act++) {
-    p_stream << '"' << EscapeQuotes(p_infoset->GetAction(act)->GetLabel()) << "\" ";
-    if (p_infoset->IsChanceInfoset()) {
-      p_stream << p_infoset->GetActionProb(act, "") << ' ';
+void GameTreeRep::BuildFlatTree(void) const
+{
+  if (m_flat)  return;
+
+  GameTreeFlat *flat = new GameTreeFlat;
+
+  // Offsets of the action slots of each information set, with the
+  // chance player as player zero, so that it comes last
+  Array<Array<int> > actionOffsets(0, m_players.Length());
+  Array<int> infosetOffsets(0, m_players.Length());
+  int numActions = 0, numInfosets = 0;
+  for (int pl = 1; pl <= m_players.Length() + 1; pl++) {
+    GamePlayerRep *player = (pl <= m_players.Length()) ? m_players[pl] : m_chance;
+    int index = (pl <= m_players.Length()) ? pl : 0;
+    infosetOffsets[index] = numInfosets;
+    numInfosets += player->m_infosets.Length();
+    for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
+      actionOffsets[index].Append(numActions);
+      numActions += player->m_infosets[iset]->m_actions.Length();
+    }
+    if (pl == m_players.Length()) {
+      flat->m_numPersonalActions = numActions;
+      flat->m_numPersonalInfosets = numInfosets;
+    }
+  }
+  flat->m_numActions = numActions;
+  flat->m_chanceInfosets = m_chance->m_infosets;
+
+  int numNodes = NumNodes();
+  flat->m_parent = Array<int>(numNodes);
+  flat->m_child = Array<int>(numNodes);
+  flat->m_actionSlot = Array<int>(numNodes);
+  flat->m_infosetSlot = Array<int>(numNodes);
+  flat->m_player = Array<int>(numNodes);
+  flat->m_outcome = Array<GameOutcomeRep *>(numNodes);
+
+  flat->m_preorder = Array<int>(numNodes);
+  flat->m_postorder = Array<int>(numNodes);
+
+  // Children are pushed last-to-first, so that they are popped in order;
+  // the reverse of a traversal taking them first-to-last gives the postorder.
+  flat->m_childStart = Array<int>(numNodes + 1);
+  std::vector<GameTreeNodeRep *> nodes(numNodes + 1);
+
+  std::vector<GameTreeNodeRep *> stack;
+  stack.push_back(m_root);
+  flat->m_child[m_root->number] = flat->m_actionSlot[m_root->number] = 0;
+  for (int index = 1; !stack.empty(); index++) {
+    GameTreeNodeRep *node = stack.back();
+    stack.pop_back();
+    int n = node->number;
+    nodes[n] = node;
+    flat->m_preorder[index] = n;
+    flat->m_parent[n] = (node->m_parent) ? node->m_parent->number : 0;
+    flat->m_infosetSlot[n] = flat->m_player[n] = 0;
+    flat->m_outcome[n] = node->outcome;
+    if (node->infoset) {
+      int pl = node->infoset->m_player->m_number;
+      int iset = node->infoset->m_number;
+      flat->m_player[n] = pl;
+      flat->m_infosetSlot[n] = infosetOffsets[pl] + iset;
+      for (int i = 1; i <= node->children.Length(); i++) {
+	int c = node->children[i]->number;
+	flat->m_child[c] = i;
+	flat->m_actionSlot[c] = actionOffsets[pl][iset] + i;
+      }
+    }
+    for (int i = node->children.Length(); i >= 1; i--) {
+      stack.push_back(node->children[i]);
+    }
+  }
+
+  // Children are listed contiguously, in order of the number of the parent
+  int numChildren = 0;
+  for (int n = 1; n <= numNodes; n++) {
+    flat->m_childStart[n] = numChildren + 1;
+    numChildren += nodes[n]->children.Length();
+  }
+  flat->m_childStart[numNodes + 1] = numChildren + 1;
+  flat->m_children = Array<int>(numChildren);
+  for (int n = 1; n <= numNodes; n++) {
+    for (int i = 1; i <= nodes[n]->children.Length(); i++) {
+      flat->m_children[flat->m_childStart[n] + i - 1] = nodes[n]->children[i]->number;
     }
   }
-  p_stream << "}";
+
+  stack.push_back(m_root);
+  for (int index = numNodes; !stack.empty(); index--) {
+    GameTreeNodeRep *node = stack.back();
+    stack.pop_back();
+    flat->m_postorder[index] = node->number;
+    for (int i = 1; i <= node->children.Length(); i++) {
+      stack.push_back(node->children[i]);
+    }
+  }
+
+  m_flat = flat;
 }
 
-void WriteEfgFile(std::ostream &f, GameTreeNodeRep *n)
+const GameTreeFlat &GameTreeRep::GetFlatTree(void) const
 {
-  if (n->NumChildren() == 0)   {
-    f << "t \"" << EscapeQuotes(n->GetLabel()) << "\" ";
-    if (n->GetOutcome())  {
-      f << n->GetOutcome()->GetNumber() << " \"" <<
-	EscapeQuotes(n->GetOutcome()->GetLabel()) << "\" ";
-      f << "{ ";
-      for (int pl = 1; pl <= n->GetGame()->NumPlayers(); pl++)  {
-	f << n->GetOutcome()->GetPayoff<std::string>(pl);
+  BuildFlatTree();
+  return *m_flat;
+}
 
-	if (pl < n->GetGame()->NumPlayers()) {
-	  f << ", ";
-	}
-	else {
-	  f << " }\n";
+//------------------------------------------------------------------------
+//            GameTreeRep: Reduced normal form payoff tables
+//------------------------------------------------------------------------
+
+template <class T> long GameTreeRep::NumPayoffTableEntries(void) const
+{
+  // Counted in floating point, as the product may overflow a long
+  double entries = 1.0;
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    entries *= m_players[pl]->m_strategies.Length();
+  }
+  if (entries * m_players.Length() * sizeof(T) > (double) m_payoffTableBudget) {
+    return 0L;
+  }
+  return (long) entries;
+}
+
+/// Visits only the nodes the pure strategies in the profile can reach,
+/// following every branch at chance nodes.  p_stack is working storage,
+/// passed in so that it can be reused from one profile to the next.
+template <class T>
+void GameTreeRep::AddProfilePayoffs(const Array<GameStrategyRep *> &p_profile,
+				    T *p_payoffs, long p_stride,
+				    std::vector<std::pair<GameTreeNodeRep *, T> > &p_stack) const
+{
+  int numPlayers = m_players.Length();
+  p_stack.push_back(std::make_pair(m_root, T(1)));
+  while (!p_stack.empty()) {
+    GameTreeNodeRep *node = p_stack.back().first;
+    T prob = p_stack.back().second;
+    p_stack.pop_back();
+    if (node->outcome) {
+      for (int pl = 1; pl <= numPlayers; pl++) {
+	p_payoffs[(pl - 1) * p_stride] += prob * node->outcome->GetPayoff<T>(pl);
+      }
+    }
+    if (!node->infoset) continue;
+    if (node->infoset->m_player == m_chance) {
+      for (int i = 1; i <= node->children.Length(); i++) {
+	T p = node->infoset->GetActionProb(i, T(0));
+	if (p != T(0)) {
+	  p_stack.push_back(std::make_pair(node->children[i], prob * p));
 	}
       }
     }
     else {
-      f << "0\n";
+      GamePlayerRep *player = node->infoset->m_player;
+      int act = p_profile[player->m_number]->m_behav[node->infoset->m_number];
+      p_stack.push_back(std::make_pair(node->children[act], prob));
     }
-    return;
   }
+}
 
-  if (n->GetInfoset()->IsChanceInfoset()) {
-    f << "c \"";
+/// Fills p_table with one plane of payoffs per player, indexed by the
+/// sum of the offsets of the strategies in a contingency.  Contingencies
+/// are visited in the order of the table, with the strategy of player 1
+/// changing fastest.
+template <class T>
+void GameTreeRep::BuildPayoffTable(std::vector<T> &p_table) const
+{
+  long ncont = NumPayoffTableEntries<T>();
+  int numPlayers = m_players.Length();
+  p_table.assign(ncont * numPlayers, T(0));
+
+  Array<GameStrategyRep *> profile(numPlayers);
+  Array<int> choices(numPlayers);
+  for (int pl = 1; pl <= numPlayers; pl++) {
+    choices[pl] = 1;
+    profile[pl] = m_players[pl]->m_strategies[1];
   }
-  else {
-    f << "p \"";
-  }
-
-  f << EscapeQuotes(n->GetLabel()) << "\" ";
-  if (!n->GetInfoset()->IsChanceInfoset()) {
-    f << n->GetInfoset()->GetPlayer()->GetNumber() << ' ';
-  }
-  f << n->GetInfoset()->GetNumber() << " \"" <<
-    EscapeQuotes(n->GetInfoset()->GetLabel()) << "\" ";
-  PrintActions(f, dynamic_cast<GameTreeInfosetRep *>(n->GetInfoset().operator->()));
-  f << " ";
-  if (n->GetOutcome())  {
-    f << n->GetOutcome()->GetNumber() << " \"" <<
-      EscapeQuotes(n->GetOutcome()->GetLabel()) << "\" ";
-    f << "{ ";
-    for (int pl = 1; pl <= n->GetGame()->NumPlayers(); pl++)  {
-      f << n->GetOutcome()->GetPayoff<std::string>(pl);
-      
-      if (pl < n->GetGame()->NumPlayers())
-	f << ", ";
-      else
-	f << " }\n";
+
+  std::vector<std::pair<GameTreeNodeRep *, T> > stack;
+  for (long cont = 0; cont < ncont; cont++) {
+    AddProfilePayoffs(profile, &p_table[cont], ncont, stack);
+
+    for (int pl = 1; pl <= numPlayers; pl++) {
+      if (++choices[pl] > m_players[pl]->m_strategies.Length()) {
+	choices[pl] = 1;
+      }
+      profile[pl] = m_players[pl]->m_strategies[choices[pl]];
+      if (choices[pl] > 1)  break;
     }
   }
-  else
-    f << "0\n";
+}
+
+const double *GameTreeRep::GetPayoffTable(int pl, double) const
+{
+  const_cast<GameTreeRep *>(this)->BuildComputedValues();
+  long ncont = NumPayoffTableEntries<double>();
+  if (ncont == 0)  return 0;
+  if (m_doublePayoffs.empty()) {
+    BuildPayoffTable(m_doublePayoffs);
+  }
+  return &m_doublePayoffs[(pl - 1) * ncont];
+}
+
+const Rational *GameTreeRep::GetPayoffTable(int pl, const Rational &) const
+{
+  const_cast<GameTreeRep *>(this)->BuildComputedValues();
+  long ncont = NumPayoffTableEntries<Rational>();
+  if (ncont == 0)  return 0;
+  if (m_rationalPayoffs.empty()) {
+    BuildPayoffTable(m_rationalPayoffs);
+  }
+  return &m_rationalPayoffs[(pl - 1) * ncont];
+}
+
+//------------------------------------------------------------------------
+//                  GameTreeRep: Writing data files
+//------------------------------------------------------------------------
+
+namespace {
+
+void WriteOutcome(OutputBuffer &p_out, GameOutcomeRep *p_outcome, int p_numPlayers)
+{
+  if (!p_outcome) {
+    p_out << "0\n";
+    return;
+  }
+  p_out << p_outcome->GetNumber() << ' ';
+  p_out.Quoted(p_outcome->GetLabel()) << " { ";
+  for (int pl = 1; pl <= p_numPlayers; pl++)  {
+    p_out << p_outcome->GetPayoff<std::string>(pl);
+    p_out << ((pl < p_numPlayers) ? ", " : " }\n");
+  }
+}
 
-  for (int i = 1; i <= n->NumChildren(); 
-       WriteEfgFile(f, dynamic_cast<GameTreeNodeRep *>(n->GetChild(i++).operator->())));
+void PrintActions(OutputBuffer &p_out, GameTreeInfosetRep *p_infoset)
+{ 
+  p_out << "{ ";
+  for (int act = 1; act <= p_infoset->NumActions(); act++) {
+    p_out.Quoted(p_infoset->GetAction(act)->GetLabel()) << ' ';
+    if (p_infoset->IsChanceInfoset()) {
+      p_out << p_infoset->GetActionProb(act, std::string()) << ' ';
+    }
+  }
+  p_out << "}";
+}
+
+/// Writes the nodes of the subtree in preorder, keeping the nodes still
+/// to be visited on an explicit stack rather than recursing, so that
+/// deep trees can be written as well as wide ones
+void WriteEfgFile(OutputBuffer &p_out, GameTreeNodeRep *p_root)
+{
+  int numPlayers = p_root->GetGame()->NumPlayers();
+  std::vector<GameTreeNodeRep *> stack(1, p_root);
+  while (!stack.empty()) {
+    GameTreeNodeRep *n = stack.back();
+    stack.pop_back();
+
+    if (n->NumChildren() == 0)   {
+      p_out << "t ";
+      p_out.Quoted(n->GetLabel()) << ' ';
+      WriteOutcome(p_out, n->GetOutcome(), numPlayers);
+      continue;
+    }
+
+    GameTreeInfosetRep *infoset =
+      dynamic_cast<GameTreeInfosetRep *>(n->GetInfoset().operator->());
+    p_out << ((infoset->IsChanceInfoset()) ? "c " : "p ");
+    p_out.Quoted(n->GetLabel()) << ' ';
+    if (!infoset->IsChanceInfoset()) {
+      p_out << infoset->GetPlayer()->GetNumber() << ' ';
+    }
+    p_out << infoset->GetNumber() << ' ';
+    p_out.Quoted(infoset->GetLabel()) << ' ';
+    PrintActions(p_out, infoset);
+    p_out << ' ';
+    WriteOutcome(p_out, n->GetOutcome(), numPlayers);
+
+    for (int i = n->NumChildren(); i >= 1; i--) {
+      stack.push_back(dynamic_cast<GameTreeNodeRep *>(n->GetChild(i).operator->()));
+    }
+  }
 }
 
 } // end anonymous namespace
 
 void GameTreeRep::WriteEfgFile(std::ostream &p_file) const
 {
-  p_file << "EFG 2 R";
-  p_file << " \"" << EscapeQuotes(GetTitle()) << "\" { ";
-  for (int i = 1; i <= m_players.Length(); i++)
-    p_file << '"' << EscapeQuotes(m_players[i]->m_label) << "\" ";
-  p_file << "}\n";
-  p_file << "\"" << EscapeQuotes(GetComment()) << "\"\n\n";
-
-  Gambit::WriteEfgFile(p_file, m_root);
+  WriteEfgFile(p_file, m_root);
 }
 
 void GameTreeRep::WriteEfgFile(std::ostream &p_file, const GameNode &p_root) const
 {
-  p_file << "EFG 2 R";
-  p_file << " \"" << EscapeQuotes(GetTitle()) << "\" { ";
+  OutputBuffer out(p_file);
+  out << "EFG 2 R ";
+  out.Quoted(GetTitle()) << " { ";
   for (int i = 1; i <= m_players.Length(); i++)
-    p_file << '"' << EscapeQuotes(m_players[i]->m_label) << "\" ";
-  p_file << "}\n";
-  p_file << "\"" << EscapeQuotes(GetComment()) << "\"\n\n";
+    out.Quoted(m_players[i]->m_label) << ' ';
+  out << "}\n";
+  out.Quoted(GetComment()) << "\n\n";
 
-  Gambit::WriteEfgFile(p_file, 
+  Gambit::WriteEfgFile(out, 
 		       dynamic_cast<GameTreeNodeRep *>(p_root.operator->()));
 }
 
+///
+/// Write the reduced normal form of the tree in .nfg payoff format.
+///
+/// The payoffs are computed profile by profile as they are written,
+/// so the table of payoffs is never held in memory, however many
+/// profiles there are.  If the exact table has already been built,
+/// it is written out directly instead.
+///
 void GameTreeRep::WriteNfgFile(std::ostream &p_file) const
 { 
   // FIXME: Building computed values is logically const.
   const_cast<GameTreeRep *>(this)->BuildComputedValues();
-  GameRep::WriteNfgFile(p_file);
+
+  OutputBuffer out(p_file);
+  out << "NFG 1 R ";
+  out.Quoted(GetTitle()) << " { ";
+  for (int i = 1; i <= m_players.Length(); i++)
+    out.Quoted(m_players[i]->m_label) << ' ';
+
+  out << "}\n\n{ ";
+  
+  for (int i = 1; i <= m_players.Length(); i++)   {
+    GamePlayerRep *player = m_players[i];
+    out << "{ ";
+    for (int j = 1; j <= player->m_strategies.Length(); j++)
+      out.Quoted(player->m_strategies[j]->GetLabel()) << ' ';
+    out << "}\n";
+  }
+  out << "}\n";
+  out.Quoted(GetComment()) << "\n\n";
+
+  int numPlayers = m_players.Length();
+  if (numPlayers > 0 && !m_rationalPayoffs.empty()) {
+    long ncont = m_rationalPayoffs.size() / numPlayers;
+    for (long cont = 0; cont < ncont; cont++) {
+      for (int pl = 1; pl <= numPlayers; pl++) {
+	out << m_rationalPayoffs[(pl - 1) * ncont + cont] << ' ';
+      }
+      out << '\n';
+    }
+    out << '\n';
+    return;
+  }
+
+  Array<GameStrategyRep *> profile(numPlayers);
+  Array<int> choices(numPlayers);
+  for (int pl = 1; pl <= numPlayers; pl++) {
+    choices[pl] = 1;
+    profile[pl] = m_players[pl]->m_strategies[1];
+  }
+
+  Array<Rational> payoffs(numPlayers);
+  std::vector<std::pair<GameTreeNodeRep *, Rational> > stack;
+  while (true) {
+    for (int pl = 1; pl <= numPlayers; payoffs[pl++] = Rational(0));
+    if (numPlayers > 0) {
+      AddProfilePayoffs(profile, &payoffs[1], 1, stack);
+    }
+    for (int pl = 1; pl <= numPlayers; pl++) {
+      out << payoffs[pl] << ' ';
+    }
+    out << '\n';
+
+    int pl = 1;
+    for (; pl <= numPlayers; pl++) {
+      if (++choices[pl] > m_players[pl]->m_strategies.Length()) {
+	choices[pl] = 1;
+      }
+      profile[pl] = m_players[pl]->m_strategies[choices[pl]];
+      if (choices[pl] > 1)  break;
+    }
+    if (pl > numPlayers)  break;
+  }
+  out << '\n';
 }
 
 //------------------------------------------------------------------------
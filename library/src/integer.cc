@@ -322,7 +322,7 @@ IntegerRep* Icopy_ulong(IntegerRep* old, unsigned long x)
   while (x != 0)
   {
     src[srclen++] = extract(x);
-    x = down(x);
+    x >>= I_SHIFT;
   }
 
   IntegerRep* rep;
@@ -491,6 +491,15 @@ int Iisdouble(const IntegerRep* rep)
 
 double ratio(const Integer& num, const Integer& den)
 {
+  // Inline values exactly representable as doubles can be divided
+  // directly; the quotient is then correctly rounded.
+  static const double exact = std::ldexp(1.0, DBL_MANT_DIG);
+  if (num.rep == 0 && den.rep == 0 && den.ival != 0 &&
+      std::fabs((double) num.ival) < exact && 
+      std::fabs((double) den.ival) < exact) {
+    return (double) num.ival / (double) den.ival;
+  }
+
   Integer q, r;
   divide(num, den, q, r);
   double d1 = q.as_double();
@@ -499,10 +508,13 @@ double ratio(const Integer& num, const Integer& den)
     return d1;
   else      // use as much precision as available for fractional part
   {
+    Integer Tden, Tr;
+    const IntegerRep* denrep = den.Rep(Tden);
+    const IntegerRep* rrep = r.Rep(Tr);
     double  d2 = 0.0;
     double  d3 = 0.0; 
     int cont = 1;
-    for (int i = den.rep->len - 1; i >= 0 && cont; --i)
+    for (int i = denrep->len - 1; i >= 0 && cont; --i)
     {
 		unsigned short a = (unsigned short) (I_RADIX >> 1);
       while (a != 0)
@@ -514,13 +526,13 @@ double ratio(const Integer& num, const Integer& den)
         }
 
         d2 *= 2.0;
-        if (den.rep->s[i] & a)
+        if (denrep->s[i] & a)
           d2 += 1.0;
 
-        if (i < r.rep->len)
+        if (i < rrep->len)
         {
           d3 *= 2.0;
-          if (r.rep->s[i] & a)
+          if (rrep->s[i] & a)
             d3 += 1.0;
         }
 
@@ -591,7 +603,7 @@ int compare(const IntegerRep* x, long  y)
         while (uy != 0)
         {
           tmp[yl++] = extract(uy);
-          uy = down(uy);
+          uy >>= I_SHIFT;
         }
         diff = xl - yl;
         if (diff == 0)
@@ -620,7 +632,7 @@ int ucompare(const IntegerRep* x, long  y)
       while (uy != 0)
       {
         tmp[yl++] = extract(uy);
-        uy = down(uy);
+        uy >>= I_SHIFT;
       }
       diff = xl - yl;
       if (diff == 0)
@@ -781,7 +793,7 @@ IntegerRep* add(const IntegerRep* x, int negatex, long y, IntegerRep* r)
     while (as < topa && uy != 0)
     {
       unsigned long u = extract(uy);
-      uy = down(uy);
+      uy >>= I_SHIFT;
       sum += (unsigned long)(*as++) + u;
       *rs++ = extract(sum);
       sum = down(sum);
@@ -805,7 +817,7 @@ IntegerRep* add(const IntegerRep* x, int negatex, long y, IntegerRep* r)
     while (uy != 0)
     {
       tmp[yl++] = extract(uy);
-      uy = down(uy);
+      uy >>= I_SHIFT;
     }
     int comp = xl - yl;
     if (comp == 0)
@@ -1033,7 +1045,7 @@ IntegerRep* multiply(const IntegerRep* x, long y, IntegerRep* r)
     while (uy != 0)
     {
       tmp[yl++] = extract(uy);
-      uy = down(uy);
+      uy >>= I_SHIFT;
     }
 
     int rl = xl + yl;
@@ -1296,7 +1308,7 @@ IntegerRep* div(const IntegerRep* x, long y, IntegerRep* q)
   while (u != 0)
   {
     ys[yl++] = extract(u);
-    u = down(u);
+    u >>= I_SHIFT;
   }
 
   int comp = xl - yl;
@@ -1349,13 +1361,28 @@ IntegerRep* div(const IntegerRep* x, long y, IntegerRep* q)
 
 void divide(const Integer& Ix, long y, Integer& Iq, long& rem)
 {
-  const IntegerRep* x = Ix.rep;
-  nonnil(x);
-  IntegerRep* q = Iq.rep;
-  int xl = x->len;
   if (y == 0) {
     throw Gambit::ZeroDivideException();
   }
+  if (Ix.rep == 0 && y != LONG_MIN) {
+    long x = Ix.ival;
+    rem = x % y;
+    Iq.SetInline(x / y);
+    return;
+  }
+  if (y > 0x7fffffffL || y < -0x7fffffffL) {
+    // The single-precision divisor code below handles at most two limbs
+    Integer r;
+    divide(Ix, Integer(y), Iq, r);
+    rem = r.as_long();
+    return;
+  }
+
+  Integer Tx;
+  const IntegerRep* x = Ix.Rep(Tx);
+  nonnil(x);
+  IntegerRep* q = Iq.rep;
+  int xl = x->len;
   unsigned short ys[SHORT_PER_LONG];
   unsigned long u;
   int ysgn = y >= 0;
@@ -1367,7 +1394,7 @@ void divide(const Integer& Ix, long y, Integer& Iq, long& rem)
   while (u != 0)
   {
     ys[yl++] = extract(u);
-    u = down(u);
+    u >>= I_SHIFT;
   }
 
   int comp = xl - yl;
@@ -1429,14 +1456,26 @@ void divide(const Integer& Ix, long y, Integer& Iq, long& rem)
   q->sgn = samesign;
   Icheck(q);
   Iq.rep = q;
+  Iq.Compact();
 }
 
 
 void divide(const Integer& Ix, const Integer& Iy, Integer& Iq, Integer& Ir)
 {
-  const IntegerRep* x = Ix.rep;
+  if (Ix.rep == 0 && Iy.rep == 0) {
+    long x = Ix.ival, y = Iy.ival;
+    if (y == 0) {
+      throw Gambit::ZeroDivideException();
+    }
+    Iq.SetInline(x / y);
+    Ir.SetInline(x % y);
+    return;
+  }
+
+  Integer Tx, Ty;
+  const IntegerRep* x = Ix.Rep(Tx);
   nonnil(x);
-  const IntegerRep* y = Iy.rep;
+  const IntegerRep* y = Iy.Rep(Ty);
   nonnil(y);
   IntegerRep* q = Iq.rep;
   IntegerRep* r = Ir.rep;
@@ -1503,6 +1542,8 @@ void divide(const Integer& Ix, const Integer& Iy, Integer& Iq, Integer& Ir)
   Iq.rep = q;
   Icheck(r);
   Ir.rep = r;
+  Iq.Compact();
+  Ir.Compact();
 }
 
 IntegerRep* mod(const IntegerRep* x, const IntegerRep* y, IntegerRep* r)
@@ -1578,7 +1619,7 @@ IntegerRep* mod(const IntegerRep* x, long y, IntegerRep* r)
   while (u != 0)
   {
     ys[yl++] = extract(u);
-    u = down(u);
+    u >>= I_SHIFT;
   }
 
   int comp = xl - yl;
@@ -1775,7 +1816,7 @@ IntegerRep* bitop(const IntegerRep* x, long y, IntegerRep* r, char op)
   while (u != 0)
   {
 	 tmp[l++] = extract(u);
-	 u = down(u);
+	 u >>= I_SHIFT;
   }
 
   int xl = x->len;
@@ -1856,11 +1897,13 @@ void (setbit)(Integer& x, long b)
   {
 	 int bw = (int) ((unsigned long)b / I_SHIFT);
 	 int sw = (int) ((unsigned long)b % I_SHIFT);
-    int xl = x.rep ? x.rep->len : 0;
+    x.Expand();
+    int xl = x.rep->len;
     if (xl <= bw)
       x.rep = Iresize(x.rep, calc_len(xl, bw+1, 0));
     x.rep->s[bw] |= (1 << sw);
     Icheck(x.rep);
+    x.Compact();
   }
 }
 
@@ -1868,26 +1911,25 @@ void clearbit(Integer& x, long b)
 {
   if (b >= 0)
     {
-      if (x.rep == 0)
-	x.rep = &_ZeroRep;
-      else
-	{
-	  int bw = (int) ((unsigned long)b / I_SHIFT);
-	  int sw = (int) ((unsigned long)b % I_SHIFT);
-	  if (x.rep->len > bw)
-	    x.rep->s[bw] &= ~(1 << sw);
-	}
-    Icheck(x.rep);
+      x.Expand();
+      int bw = (int) ((unsigned long)b / I_SHIFT);
+      int sw = (int) ((unsigned long)b % I_SHIFT);
+      if (x.rep->len > bw)
+	x.rep->s[bw] &= ~(1 << sw);
+      Icheck(x.rep);
+      x.Compact();
   }
 }
 
 int testbit(const Integer& x, long b)
 {
-  if (x.rep != 0 && b >= 0)
+  if (b >= 0)
   {
+    Integer Tx;
+    const IntegerRep* xrep = x.Rep(Tx);
 	 int bw = (int) ((unsigned long)b / I_SHIFT);
 	 int sw = (int) ((unsigned long)b % I_SHIFT);
-    return (bw < x.rep->len && (x.rep->s[bw] & (1 << sw)) != 0);
+    return (bw < xrep->len && (xrep->s[bw] & (1 << sw)) != 0);
   }
   else
     return 0;
@@ -2196,7 +2238,8 @@ std::string Itoa(const IntegerRep *x, int base, int width)
 
 std::ostream &operator<<(std::ostream &s, const Integer &y)
 {
-  return s << Itoa(y.rep);
+  Integer Ty;
+  return s << Itoa(y.Rep(Ty));
 }
 
 std::string cvtItoa(const IntegerRep *x, std::string fmt, int& fmtlen, int base, int showbase,
@@ -2295,7 +2338,7 @@ std::istream &operator>>(std::istream &s, Integer& y)
 {
   char sgn = 0;
   char ch;
-  y.rep = Icopy_zero(y.rep);
+  y = 0L;
 
   do  {
 	 s.get(ch);
@@ -2334,7 +2377,11 @@ std::istream &operator>>(std::istream &s, Integer& y)
 
 int Integer::OK() const
 {
-  if (rep != 0)
+  if (rep == 0) {
+    if (ival >= -LONG_MAX)
+      return 1;
+  }
+  else
 	 {
       int l = rep->len;
       int s = rep->sgn;
@@ -2356,183 +2403,401 @@ void Integer::error(const char* msg) const
   //  gerr << msg << '\n';
 }
 
+//
+// Inline values.  Values in [-LONG_MAX, LONG_MAX] are held in ival, with
+// rep null; LONG_MIN is excluded so that negation and absolute value
+// cannot overflow.  The operations below work directly on inline values
+// when both operands are inline and the result fits, and otherwise fall
+// back to the multiple-precision routines, moving the result back inline
+// when it fits.
+//
+
+static inline int Iislong_inline(long x)
+{
+  return x >= -LONG_MAX;
+}
+
+static inline int Iadd_inline(long x, long y, long &r)
+{
+  if ((y > 0 && x > LONG_MAX - y) || (y < 0 && x < -LONG_MAX - y))
+    return 0;
+  r = x + y;
+  return 1;
+}
+
+static inline int Imul_inline(long x, long y, long &r)
+{
+  unsigned long ux = (x >= 0) ? (unsigned long) x : -(unsigned long) x;
+  unsigned long uy = (y >= 0) ? (unsigned long) y : -(unsigned long) y;
+  if (uy != 0 && ux > (unsigned long) LONG_MAX / uy)
+    return 0;
+  r = x * y;
+  return 1;
+}
+
+static inline long Igcd_inline(long x, long y)
+{
+  unsigned long u = (x >= 0) ? x : -x;
+  unsigned long v = (y >= 0) ? y : -y;
+  while (v != 0) {
+    unsigned long t = u % v;
+    u = v;
+    v = t;
+  }
+  return (long) u;
+}
+
+void Integer::SetInline(long y)
+{
+  if (rep != 0 && !STATIC_IntegerRep(rep)) delete[] rep;
+  rep = 0;
+  ival = y;
+}
+
+void Integer::Expand(void)
+{
+  if (rep == 0) rep = Icopy_long(0, ival);
+}
 
+void Integer::Compact(void)
+{
+  if (rep != 0 && (unsigned)(rep->len) <= (unsigned)(SHORT_PER_LONG) &&
+      Iislong(rep)) {
+    long y = Itolong(rep);
+    if (Iislong_inline(y)) SetInline(y);
+  }
+}
+
+const IntegerRep *Integer::Rep(Integer &p_temp) const
+{
+  if (rep != 0) return rep;
+  p_temp.rep = Icopy_long(p_temp.rep, ival);
+  return p_temp.rep;
+}
 
 // The following were moved from the header file to stop BC from squealing
 // endless quantities of warnings
 
-Integer::Integer() :rep(&_ZeroRep) {}
+Integer::Integer() :rep(0), ival(0) {}
 
-Integer::Integer(IntegerRep* r) :rep(r) {}
+Integer::Integer(IntegerRep* r) :rep(r), ival(0) { if (rep) Compact(); }
 
-Integer::Integer(int y) :rep(Icopy_long(0, (long)y)) {}
+Integer::Integer(int y) :rep(0), ival(y) 
+{
+  if (!Iislong_inline(ival)) rep = Icopy_long(0, ival);
+}
 
-Integer::Integer(long y) :rep(Icopy_long(0, y)) {}
+Integer::Integer(long y) :rep(0), ival(y)
+{
+  if (!Iislong_inline(ival)) rep = Icopy_long(0, ival);
+}
 
-Integer::Integer(unsigned long y) :rep(Icopy_ulong(0, y)) {}
+Integer::Integer(unsigned long y) :rep(0), ival(0)
+{
+  if (y <= (unsigned long) LONG_MAX) ival = (long) y;
+  else rep = Icopy_ulong(0, y);
+}
 
-Integer::Integer(const Integer&  y) :rep(Icopy(0, y.rep)) {}
+Integer::Integer(const Integer&  y) 
+  :rep((y.rep) ? Icopy(0, y.rep) : 0), ival(y.ival) {}
 
 Integer::~Integer() { if (rep && !STATIC_IntegerRep(rep)) delete[] rep; }
 
 Integer &Integer::operator=(const Integer &y)
 {
-  rep = Icopy(rep, y.rep);
+  if (y.rep == 0) 
+    SetInline(y.ival);
+  else
+    rep = Icopy(rep, y.rep);
   return *this;
 }
 
 Integer &Integer::operator=(long y)
 {
-  rep = Icopy_long(rep, y); 
+  if (Iislong_inline(y))
+    SetInline(y);
+  else
+    rep = Icopy_long(rep, y); 
   return *this;
 }
 
 int Integer::initialized() const
 {
-  return rep != 0;
+  // An inline value is always initialized
+  return 1;
 }
 
 // procedural versions
 
 int compare(const Integer& x, const Integer& y)
 {
-  return compare(x.rep, y.rep);
+  if (x.rep == 0 && y.rep == 0)
+    return (x.ival > y.ival) - (x.ival < y.ival);
+  Integer Tx, Ty;
+  return compare(x.Rep(Tx), y.Rep(Ty));
 }
 
 int ucompare(const Integer& x, const Integer& y)
 {
-  return ucompare(x.rep, y.rep);
+  if (x.rep == 0 && y.rep == 0) {
+    long ux = (x.ival >= 0) ? x.ival : -x.ival;
+    long uy = (y.ival >= 0) ? y.ival : -y.ival;
+    return (ux > uy) - (ux < uy);
+  }
+  Integer Tx, Ty;
+  return ucompare(x.Rep(Tx), y.Rep(Ty));
 }
 
 int compare(const Integer& x, long y)
 {
+  if (x.rep == 0)
+    return (x.ival > y) - (x.ival < y);
   return compare(x.rep, y);
 }
 
 int ucompare(const Integer& x, long y)
 {
-  return ucompare(x.rep, y);
+  if (x.rep == 0 && Iislong_inline(y)) {
+    long ux = (x.ival >= 0) ? x.ival : -x.ival;
+    long uy = (y >= 0) ? y : -y;
+    return (ux > uy) - (ux < uy);
+  }
+  Integer Tx;
+  return ucompare(x.Rep(Tx), y);
 }
 
 int compare(long x, const Integer& y)
 {
-  return -compare(y.rep, x);
+  return -compare(y, x);
 }
 
 int ucompare(long x, const Integer& y)
 {
-  return -ucompare(y.rep, x);
+  return -ucompare(y, x);
 }
 
 void  add(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, y.rep, 0, dest.rep);
+  long r;
+  if (x.rep == 0 && y.rep == 0 && Iadd_inline(x.ival, y.ival, r)) {
+    dest.SetInline(r);
+    return;
+  }
+  Integer Tx, Ty;
+  dest.rep = add(x.Rep(Tx), 0, y.Rep(Ty), 0, dest.rep);
+  dest.Compact();
 }
 
 void  sub(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, y.rep, 1, dest.rep);
+  long r;
+  if (x.rep == 0 && y.rep == 0 && Iadd_inline(x.ival, -y.ival, r)) {
+    dest.SetInline(r);
+    return;
+  }
+  Integer Tx, Ty;
+  dest.rep = add(x.Rep(Tx), 0, y.Rep(Ty), 1, dest.rep);
+  dest.Compact();
 }
 
 void  mul(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = multiply(x.rep, y.rep, dest.rep);
+  long r;
+  if (x.rep == 0 && y.rep == 0 && Imul_inline(x.ival, y.ival, r)) {
+    dest.SetInline(r);
+    return;
+  }
+  Integer Tx, Ty;
+  dest.rep = multiply(x.Rep(Tx), y.Rep(Ty), dest.rep);
+  dest.Compact();
 }
 
 void  div(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = div(x.rep, y.rep, dest.rep);
+  if (x.rep == 0 && y.rep == 0) {
+    if (y.ival == 0) {
+      throw Gambit::ZeroDivideException();
+    }
+    dest.SetInline(x.ival / y.ival);
+    return;
+  }
+  Integer Tx, Ty;
+  dest.rep = div(x.Rep(Tx), y.Rep(Ty), dest.rep);
+  dest.Compact();
 }
 
 void  mod(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = mod(x.rep, y.rep, dest.rep);
+  if (x.rep == 0 && y.rep == 0) {
+    if (y.ival == 0) {
+      throw Gambit::ZeroDivideException();
+    }
+    dest.SetInline(x.ival % y.ival);
+    return;
+  }
+  Integer Tx, Ty;
+  dest.rep = mod(x.Rep(Tx), y.Rep(Ty), dest.rep);
+  dest.Compact();
 }
 
 void  lshift(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = lshift(x.rep, y.rep, 0, dest.rep);
+  Integer Tx, Ty;
+  dest.rep = lshift(x.Rep(Tx), y.Rep(Ty), 0, dest.rep);
+  dest.Compact();
 }
 
 void  rshift(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = lshift(x.rep, y.rep, 1, dest.rep);
+  Integer Tx, Ty;
+  dest.rep = lshift(x.Rep(Tx), y.Rep(Ty), 1, dest.rep);
+  dest.Compact();
 }
 
 void  pow(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = power(x.rep, Itolong(y.rep), dest.rep); // not incorrect
+  Integer Tx;
+  dest.rep = power(x.Rep(Tx), y.as_long(), dest.rep); // not incorrect
+  dest.Compact();
 }
 
 void  add(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, y, dest.rep);
+  if (!Iislong_inline(y)) {
+    // The long-operand routines below cannot represent LONG_MIN
+    add(x, Integer(y), dest);
+    return;
+  }
+  long r;
+  if (x.rep == 0 && Iadd_inline(x.ival, y, r)) {
+    dest.SetInline(r);
+    return;
+  }
+  Integer Tx;
+  dest.rep = add(x.Rep(Tx), 0, y, dest.rep);
+  dest.Compact();
 }
 
 void  sub(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, -y, dest.rep);
+  if (!Iislong_inline(y)) {
+    // -y would overflow
+    sub(x, Integer(y), dest);
+    return;
+  }
+  long r;
+  if (x.rep == 0 && Iadd_inline(x.ival, -y, r)) {
+    dest.SetInline(r);
+    return;
+  }
+  Integer Tx;
+  dest.rep = add(x.Rep(Tx), 0, -y, dest.rep);
+  dest.Compact();
 }
 
 void  mul(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = multiply(x.rep, y, dest.rep);
+  long r;
+  if (x.rep == 0 && Iislong_inline(y) && Imul_inline(x.ival, y, r)) {
+    dest.SetInline(r);
+    return;
+  }
+  Integer Tx;
+  dest.rep = multiply(x.Rep(Tx), y, dest.rep);
+  dest.Compact();
 }
 
 void  div(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = div(x.rep, y, dest.rep);
+  if (x.rep == 0 && Iislong_inline(y)) {
+    if (y == 0) {
+      throw Gambit::ZeroDivideException();
+    }
+    dest.SetInline(x.ival / y);
+    return;
+  }
+  div(x, Integer(y), dest);
 }
 
 void  mod(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = mod(x.rep, y, dest.rep);
+  if (x.rep == 0 && Iislong_inline(y)) {
+    if (y == 0) {
+      throw Gambit::ZeroDivideException();
+    }
+    dest.SetInline(x.ival % y);
+    return;
+  }
+  mod(x, Integer(y), dest);
 }
 
 
 void  lshift(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = lshift(x.rep, y, dest.rep);
+  Integer Tx;
+  dest.rep = lshift(x.Rep(Tx), y, dest.rep);
+  dest.Compact();
 }
 
 void  rshift(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = lshift(x.rep, -y, dest.rep);
+  Integer Tx;
+  dest.rep = lshift(x.Rep(Tx), -y, dest.rep);
+  dest.Compact();
 }
 
 void  pow(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = power(x.rep, y, dest.rep);
+  Integer Tx;
+  dest.rep = power(x.Rep(Tx), y, dest.rep);
+  dest.Compact();
 }
 
 void abs(const Integer& x, Integer& dest)
 {
+  if (x.rep == 0) {
+    dest.SetInline((x.ival >= 0) ? x.ival : -x.ival);
+    return;
+  }
   dest.rep = abs(x.rep, dest.rep);
 }
 
 void negate(const Integer& x, Integer& dest)
 {
+  if (x.rep == 0) {
+    dest.SetInline(-x.ival);
+    return;
+  }
   dest.rep = negate(x.rep, dest.rep);
 }
 
 void complement(const Integer& x, Integer& dest)
 {
-  dest.rep = Compl(x.rep, dest.rep);
+  Integer Tx;
+  dest.rep = Compl(x.Rep(Tx), dest.rep);
+  dest.Compact();
 }
 
 void  add(long x, const Integer& y, Integer& dest)
 {
-  dest.rep = add(y.rep, 0, x, dest.rep);
+  add(y, x, dest);
 }
 
 void  sub(long x, const Integer& y, Integer& dest)
 {
-  dest.rep = add(y.rep, 1, x, dest.rep);
+  long r;
+  if (y.rep == 0 && Iadd_inline(x, -y.ival, r) && Iislong_inline(r)) {
+    dest.SetInline(r);
+    return;
+  }
+  Integer Ty;
+  dest.rep = add(y.Rep(Ty), 1, x, dest.rep);
+  dest.Compact();
 }
 
 void  mul(long x, const Integer& y, Integer& dest)
 {
-  dest.rep = multiply(y.rep, x, dest.rep);
+  mul(y, x, dest);
 }
 
 // operator versions
@@ -2698,29 +2963,37 @@ void Integer::negate()
 
 int sign(const Integer& x)
 {
+  if (x.rep == 0)
+    return (x.ival > 0) - (x.ival < 0);
   return (x.rep->len == 0) ? 0 : ( (x.rep->sgn == 1) ? 1 : -1 );
 }
 
 int even(const Integer& y)
 {
+  if (y.rep == 0)
+    return !(y.ival & 1);
   return y.rep->len == 0 || !(y.rep->s[0] & 1);
 }
 
 int odd(const Integer& y)
 {
+  if (y.rep == 0)
+    return (y.ival & 1) != 0;
   return y.rep->len > 0 && (y.rep->s[0] & 1);
 }
 
 std::string Itoa(const Integer& y, int base, int width)
 {
-  return Itoa(y.rep, base, width);
+  Integer Ty;
+  return Itoa(y.Rep(Ty), base, width);
 }
 
 
 
 long lg(const Integer& x) 
 {
-  return lg(x.rep);
+  Integer Tx;
+  return lg(x.Rep(Tx));
 }
 
 // constructive operations 
@@ -2872,13 +3145,20 @@ Integer  atoI(const char* s, int base)
 {
   Integer r;
   r.rep = atoIntegerRep(s, base);
+  r.Compact();
   return r;
 }
 
 Integer  gcd(const Integer& x, const Integer& y)
 {
   Integer r;
-  r.rep = gcd(x.rep, y.rep);
+  if (x.rep == 0 && y.rep == 0) {
+    r.ival = Igcd_inline(x.ival, y.ival);
+    return r;
+  }
+  Integer Tx, Ty;
+  r.rep = gcd(x.Rep(Tx), y.Rep(Ty));
+  r.Compact();
   return r;
 }
 
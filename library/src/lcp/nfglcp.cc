@@ -23,8 +23,10 @@
 #include <cstdio>
 //#include <unistd.h>
 #include <iostream>
+#include <memory>
 
 #include "gambit/gambit.h"
+#include "gambit/parallel.h"
 #include "gambit/linalg/lhtab.h"
 #include "gambit/nash/lcp.h"
 
@@ -112,21 +114,38 @@ template <class T> Vector<T> Make_b2(const Game &p_game)
   return b2;
 }
 
+//
+// A copy of a floating-point tableau solves through the LU decomposition
+// of the tableau it was copied from, and updates that tableau's count of
+// copies.  Once detached from the original, the copy needs a decomposition
+// of its own before it is pivoted.  Copies of rational tableaus are
+// already independent.
+//
+void Factor(linalg::LHTableau<double> &p_tableau) { p_tableau.Refactor(); }
+void Factor(linalg::LHTableau<Rational> &) { }
+
 }  // end anonymous namespace
   
 
 template <class T>
 class NashLcpStrategySolver<T>::Solution {
 public:
-  List<Gambit::linalg::BFS<T> > m_bfsList;
+  Gambit::linalg::BasisSet m_bases;
   List<MixedStrategyProfile<T> > m_equilibria;
+  /// Guards the solution when paths are followed concurrently
+  std::mutex m_mutex;
+  /// Set once the requested number of equilibria has been found
+  std::atomic<bool> m_done;
+
+  Solution(void) : m_done(false) { }
 
   bool Contains(const Gambit::linalg::BFS<T> &p_bfs) const
-  { return m_bfsList.Contains(p_bfs); }
+  { return m_bases.Contains(p_bfs); }
   void push_back(const Gambit::linalg::BFS<T> &p_bfs)
-  { m_bfsList.push_back(p_bfs); }
+  { m_bases.Insert(p_bfs); }
 
   int EquilibriumCount(void) const { return m_equilibria.size(); }
+  bool IsDone(void) const { return m_done; }
 };
   
 //
@@ -142,7 +161,8 @@ NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
 				Solution &p_solution) const
 {
   Gambit::linalg::BFS<T> cbfs(p_tableau.GetBFS());
-  if (p_solution.Contains(cbfs)) {
+  std::lock_guard<std::mutex> lock(p_solution.m_mutex);
+  if (p_solution.IsDone() || p_solution.Contains(cbfs)) {
     return false;
   }
   p_solution.push_back(cbfs);
@@ -189,7 +209,7 @@ NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
   p_solution.m_equilibria.push_back(profile);
 
   if (m_stopAfter > 0 && p_solution.EquilibriumCount() >= m_stopAfter) {
-    throw EquilibriumLimitReached();
+    p_solution.m_done = true;
   }
 
   return true;
@@ -218,7 +238,7 @@ NashLcpStrategySolver<T>::AllLemke(const Game &p_game,
     return;
   }
   
-  for (int i = B.MinCol(); i <= B.MaxCol(); i++) {
+  for (int i = B.MinCol(); i <= B.MaxCol() && !p_solution.IsDone(); i++) {
     if (i != j)  {
       linalg::LHTableau<T> Bcopy(B);
       Bcopy.LemkePath(i);
@@ -227,6 +247,72 @@ NashLcpStrategySolver<T>::AllLemke(const Game &p_game,
   }
 }
 
+//
+// The parallel version of AllLemke.  Each Branch is a path yet to be
+// followed: the tableau at the CBFS where the path starts, shared among
+// all paths leaving that CBFS, and the label to drop.  Following a path
+// and expanding the CBFS it leads to is one task on a WorkQueue.
+// The children of a CBFS are pushed in reverse order so that, with one
+// thread, they are explored in the same order as by AllLemke.
+//
+template <class T> class NashLcpStrategySolver<T>::Branch {
+public:
+  std::shared_ptr<const linalg::LHTableau<T> > m_tableau;
+  int m_label, m_depth;
+
+  Branch(const std::shared_ptr<const linalg::LHTableau<T> > &p_tableau,
+	 int p_label, int p_depth)
+    : m_tableau(p_tableau), m_label(p_label), m_depth(p_depth) { }
+};
+
+template <class T> class NashLcpStrategySolver<T>::BranchTask {
+public:
+  BranchTask(const NashLcpStrategySolver<T> &p_solver, const Game &p_game,
+	     Solution &p_solution)
+    : m_solver(p_solver), m_game(p_game), m_solution(p_solution) { }
+
+  void operator()(const Branch &p_branch, WorkQueue<Branch> &p_queue)
+  {
+    if (m_solution.IsDone()) {
+      p_queue.Cancel();
+      return;
+    }
+    std::shared_ptr<linalg::LHTableau<T> > B;
+    {
+      // The tableau is shared with the other paths leaving its CBFS,
+      // which count their copies of it in its decomposition.
+      std::lock_guard<std::mutex> lock(m_copyMutex);
+      B.reset(new linalg::LHTableau<T>(*p_branch.m_tableau));
+      B->Detach();
+    }
+    Factor(*B);
+    B->LemkePath(p_branch.m_label);
+    if (!m_solver.OnBFS(m_game, *B, m_solution)) {
+      return;
+    }
+    Expand(B, p_branch.m_label, p_branch.m_depth, p_queue);
+  }
+
+  void Expand(const std::shared_ptr<const linalg::LHTableau<T> > &B,
+	      int j, int depth, WorkQueue<Branch> &p_queue)
+  {
+    if (m_solver.m_maxDepth != 0 && depth + 1 > m_solver.m_maxDepth) {
+      return;
+    }
+    for (int i = B->MaxCol(); i >= B->MinCol(); i--) {
+      if (i != j) {
+	p_queue.Push(Branch(B, i, depth + 1));
+      }
+    }
+  }
+
+private:
+  const NashLcpStrategySolver<T> &m_solver;
+  const Game &m_game;
+  Solution &m_solution;
+  std::mutex m_copyMutex;
+};
+
 template <class T> List<MixedStrategyProfile<T> > 
 NashLcpStrategySolver<T>::Solve(const Game &p_game) const
 {
@@ -243,19 +329,25 @@ NashLcpStrategySolver<T>::Solve(const Game &p_game) const
     Vector<T> b1 = Make_b1<T>(p_game);
     Matrix<T> A2 = Make_A2<T>(p_game);
     Vector<T> b2 = Make_b2<T>(p_game);
-    linalg::LHTableau<T> B(A1, A2, b1, b2);
 
-    if (m_stopAfter != 1) {
-      AllLemke(p_game, 0, B, solution, 0);
-    }
-    else  {
+    if (m_stopAfter == 1) {
+      linalg::LHTableau<T> B(A1, A2, b1, b2);
       B.LemkePath(1);
       OnBFS(p_game, B, solution);
     }
-  }
-  catch (EquilibriumLimitReached &) {
-    // This pseudo-exception requires no additional action;
-    // solution contains details of all equilibria found
+    else if (m_numThreads == 1) {
+      linalg::LHTableau<T> B(A1, A2, b1, b2);
+      AllLemke(p_game, 0, B, solution, 0);
+    }
+    else {
+      // On the initial expansion, the CBFS we are at is the extraneous
+      // solution.
+      std::shared_ptr<const linalg::LHTableau<T> > B(new linalg::LHTableau<T>(A1, A2, b1, b2));
+      WorkQueue<Branch> queue;
+      BranchTask task(*this, p_game, solution);
+      task.Expand(B, 0, 0, queue);
+      queue.Run(m_numThreads, task);
+    }
   }
   catch (std::runtime_error &e) {
     std::cerr << "ERROR: " << e.what() << std::endl;
@@ -116,6 +116,11 @@ void Tableau<double>::Refactor()
   Solve(*b, solution);
 }
 
+void Tableau<double>::Detach()
+{
+  B.detach();
+}
+
 void Tableau<double>::SetRefactor(int n)
 {
   B.SetRefactor(n);
@@ -479,6 +484,9 @@ void Tableau<Rational>::Refactor()
 void Tableau<Rational>::SetRefactor(int)
 { }
 
+void Tableau<Rational>::Detach()
+{ }
+
 void Tableau<Rational>::SetConst(const Vector<Rational> &bnew)
 {
   b=&bnew;
@@ -20,7 +20,13 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
 #include "gambit/nash.h"
+#include "gambit/parallel.h"
 
 namespace Gambit {
 
@@ -219,8 +225,10 @@ BehavViaStrategySolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 
 template <class T>
 SubgameBehavSolver<T>::SubgameBehavSolver(shared_ptr<BehavSolver<T> > p_solver,
-						  shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium /* = 0 */)
-  : BehavSolver<T>(p_onEquilibrium), m_solver(p_solver)
+					  shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium /* = 0 */,
+					  int p_numThreads /* = 1 */)
+  : BehavSolver<T>(p_onEquilibrium), m_solver(p_solver),
+    m_numThreads(p_numThreads)
 { }
 
 // A nested anonymous namespace to privatize these functions 
@@ -242,17 +250,157 @@ void ChildSubgames(const GameNode &p_node, List<GameNode> &p_list)
   }
 }
 
-} // end nested anonymous namespace
+///
+/// Appends to p_key a description of the subtree rooted at p_node,
+/// covering its shape, players, information sets, chance probabilities
+/// and payoffs, but not its labels.  Information sets are identified by
+/// their order of first appearance, and for each player p_infosets lists
+/// them in that order, which is also the order in which they are
+/// numbered in a copy of the subtree.
+///
+void SubgameKey(const GameNode &p_node, bool p_isRoot,
+		std::string &p_key, Array<List<GameInfoset> > &p_infosets,
+		std::map<GameInfosetRep *, int> &p_indices)
+{
+  if (!p_isRoot && p_node->GetOutcome()) {
+    GameOutcome outcome = p_node->GetOutcome();
+    p_key += '{';
+    for (int pl = 1; pl <= p_infosets.Length(); pl++) {
+      p_key += outcome->GetPayoff<std::string>(pl);
+      p_key += ',';
+    }
+    p_key += '}';
+  }
+  GameInfoset infoset = p_node->GetInfoset();
+  if (!infoset) {
+    p_key += "t;";
+    return;
+  }
+  if (infoset->IsChanceInfoset()) {
+    p_key += 'c';
+    for (int act = 1; act <= infoset->NumActions(); act++) {
+      p_key += infoset->GetActionProb(act, "");
+      p_key += ',';
+    }
+  }
+  else {
+    int pl = infoset->GetPlayer()->GetNumber();
+    int &index = p_indices[infoset];
+    if (index == 0) {
+      p_infosets[pl].Append(infoset);
+      index = p_infosets[pl].Length();
+    }
+    p_key += 'p' + lexical_cast<std::string>(pl) + ':' +
+      lexical_cast<std::string>(index) + ':' +
+      lexical_cast<std::string>(infoset->NumActions());
+  }
+  p_key += ';';
+  for (int i = 1; i <= p_node->NumChildren(); i++) {
+    SubgameKey(p_node->GetChild(i), false, p_key, p_infosets, p_indices);
+  }
+}
+
+///
+/// The equilibria of a subgame, held apart from the subgame itself so
+/// that they can be reused for identical subgames.  Each profile lists
+/// the action probabilities in the usual order of a behavior profile,
+/// and each payoff vector excludes the outcome at the root.
+///
+template <class T> class SubgameSolutions {
+public:
+  List<Vector<T> > m_profiles, m_payoffs;
+};
+
+///
+/// Solutions to subgames, indexed by SubgameKey().  A subgame being
+/// solved is marked as pending, so that a thread arriving at an
+/// identical subgame waits for its solution rather than solving it
+/// again.
+///
+template <class T> class SubgameCache {
+public:
+  /// Returns true and sets p_solutions if the subgame has been solved;
+  /// otherwise, marks it as pending and returns false, in which case
+  /// the caller must call either Insert() or Abandon() on the key.
+  bool Find(const std::string &p_key, SubgameSolutions<T> &p_solutions)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_pending.count(p_key)) {
+      m_ready.wait(lock);
+    }
+    typename std::map<std::string, SubgameSolutions<T> >::const_iterator entry =
+      m_solutions.find(p_key);
+    if (entry != m_solutions.end()) {
+      p_solutions = entry->second;
+      return true;
+    }
+    m_pending.insert(p_key);
+    return false;
+  }
+
+  void Insert(const std::string &p_key, const SubgameSolutions<T> &p_solutions)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_solutions[p_key] = p_solutions;
+    m_pending.erase(p_key);
+    m_ready.notify_all();
+  }
+
+  void Abandon(const std::string &p_key)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.erase(p_key);
+    m_ready.notify_all();
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_ready;
+  std::map<std::string, SubgameSolutions<T> > m_solutions;
+  std::set<std::string> m_pending;
+};
+
+template <class T> class SubgameDecomposition;
+
+///
+/// Solves one of the proper subgames beneath the root of a game, in the
+/// game copied from it.
+///
+template <class T> class ChildSubgameTask {
+public:
+  ChildSubgameTask(const SubgameDecomposition<T> &p_decomposition,
+		   const Array<Game> &p_games,
+		   const Array<std::map<GameInfosetRep *, int> > &p_ids,
+		   int p_numThreads,
+		   Array<List<DVector<T> > > &p_solns,
+		   Array<List<Vector<T> > > &p_values)
+    : m_decomposition(p_decomposition), m_games(p_games), m_ids(p_ids),
+      m_numThreads(p_numThreads), m_solns(p_solns), m_values(p_values) { }
+
+  void operator()(int i)
+  {
+    m_decomposition.Solve(m_games[i], m_ids[i], m_numThreads,
+			  m_solns[i], m_values[i]);
+  }
+
+private:
+  const SubgameDecomposition<T> &m_decomposition;
+  const Array<Game> &m_games;
+  const Array<std::map<GameInfosetRep *, int> > &m_ids;
+  int m_numThreads;
+  Array<List<DVector<T> > > &m_solns;
+  Array<List<Vector<T> > > &m_values;
+};
 
 //
 // Some general notes on the strategy for solving by subgames:
 //
-// * We work with a *copy* of the original game, which is destroyed
-//   as we go.
-// * Before solving, information set labels on the copy game are
-//   set to unique IDs.  These are used to match up information
-//   sets in the subgames (which are themselves copies) to the
-//   original game.
+// * Each subgame is solved in its own copy, which is destroyed as we
+//   go; as no two subgames share a game, sibling subgames can be
+//   solved concurrently.
+// * Information sets of each copy are mapped to their numbers in the
+//   game being solved, so that the solutions to subgames can be
+//   written into a profile on the whole game.
 // * We only carry around DVectors instead of full MixedBehaviorProfiles,
 //   because MixedBehaviorProfiles allocate space several times the
 //   size of the tree to carry around useful quantities.  These
@@ -260,168 +408,203 @@ void ChildSubgames(const GameNode &p_node, List<GameNode> &p_list)
 //   store the probabilities, and convert to MixedBehaviorProfiles
 //   at the end of the computation
 //
+template <class T> class SubgameDecomposition {
+public:
+  SubgameDecomposition(const BehavSolver<T> &p_solver,
+		       const DVector<T> &p_templateSolution)
+    : m_solver(p_solver), m_templateSolution(p_templateSolution) { }
+
+  /// Computes the equilibria of p_game, together with the payoffs to
+  /// each, where p_ids gives the number in the whole game of each
+  /// information set of p_game.
+  void Solve(const Game &p_game, const std::map<GameInfosetRep *, int> &p_ids,
+	     int p_numThreads,
+	     List<DVector<T> > &solns, List<Vector<T> > &values) const;
+
+private:
+  const BehavSolver<T> &m_solver;
+  const DVector<T> &m_templateSolution;
+  mutable SubgameCache<T> m_cache;
+};
 
 template <class T>
-void SubgameBehavSolver<T>::SolveSubgames(const BehaviorSupportProfile &p_support,
-					      const DVector<T> &p_templateSolution,
-					      GameNode n,
-					      List<DVector<T> > &solns,
-					      List<GameOutcome> &values) const
+void SubgameDecomposition<T>::Solve(const Game &p_game,
+				    const std::map<GameInfosetRep *, int> &p_ids,
+				    int p_numThreads,
+				    List<DVector<T> > &solns,
+				    List<Vector<T> > &values) const
 {
-  Game efg = p_support.GetGame();
-  
+  GameNode n = p_game->GetRoot();
+
   List<DVector<T> > thissolns;
-  thissolns.Append(p_templateSolution);
+  thissolns.Append(m_templateSolution);
   ((Vector<T> &) thissolns[1]).operator=(T(0));
   
   List<GameNode> subroots;
   for (int i = 1; i <= n->NumChildren(); i++) {
     ChildSubgames(n->GetChild(i), subroots);
   }
-  
+
+  // Each child subgame is copied, and its information sets mapped to
+  // their numbers in the whole game, before any of them is solved
+  Array<Game> subgames(subroots.Length());
+  Array<std::map<GameInfosetRep *, int> > subids(subroots.Length());
+  for (int i = 1; i <= subroots.Length(); i++) {
+    Array<Array<GameInfoset> > infosets;
+    subgames[i] = subroots[i]->CopySubgame(infosets);
+    for (int pl = 1; pl <= infosets.Length(); pl++) {
+      for (int iset = 1; iset <= infosets[pl].Length(); iset++) {
+	subids[i][subgames[i]->GetPlayer(pl)->GetInfoset(iset)] =
+	  p_ids.find(infosets[pl][iset])->second;
+      }
+    }
+  }
+
+  Array<List<DVector<T> > > subsolns(subroots.Length());
+  Array<List<Vector<T> > > subvalues(subroots.Length());
+  int numThreads = NumWorkerThreads(p_numThreads);
+  if (subroots.Length() > 1 && numThreads > 1) {
+    // Threads are shared out among the children
+    int childThreads = std::max(1, numThreads / subroots.Length());
+    ChildSubgameTask<T> task(*this, subgames, subids, childThreads,
+			     subsolns, subvalues);
+    ParallelFor(subroots.Length(), numThreads, task);
+  }
+  else {
+    for (int i = 1; i <= subroots.Length(); i++) {
+      Solve(subgames[i], subids[i], numThreads, subsolns[i], subvalues[i]);
+    }
+  }
+
   List<Array<GameOutcome> > subrootvalues;
   subrootvalues.Append(Array<GameOutcome>(subroots.Length()));
   
   for (int i = 1; i <= subroots.Length(); i++)  {
-    //printf("Looking at subgame %d of %d\n", i, subroots.Length());
-    List<DVector<T> > subsolns;
-    List<GameOutcome> subvalues;
-    
-    SolveSubgames(p_support, p_templateSolution,
-		  subroots[i], subsolns, subvalues);
-    
-    if (subsolns.Length() == 0)  {
+    if (subsolns[i].Length() == 0)  {
       solns = List<DVector<T> >();
       return;
     }
 
-    //printf("Found %d subsolutions for subgame %d of %d\n", 
-    //subsolns.Length(), i, subroots.Length());
-    
+    // The subgame is replaced by a terminal node, with an outcome
+    // for each of its solutions
+    subroots[i]->DeleteTree();
+    Array<GameOutcome> outcomes(subvalues[i].Length());
+    for (int subsoln = 1; subsoln <= subvalues[i].Length(); subsoln++) {
+      outcomes[subsoln] = p_game->NewOutcome();
+      for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+	outcomes[subsoln]->SetPayoff(pl, lexical_cast<std::string>(subvalues[i][subsoln][pl]));
+      }
+    }
+
     List<DVector<T> > newsolns;
     List<Array<GameOutcome> > newsubrootvalues;
     
-    //printf("Merging with %d existing solutions\n", thissolns.Length());
     for (int soln = 1; soln <= thissolns.Length(); soln++) {
-      for (int subsoln = 1; subsoln <= subsolns.Length(); subsoln++) {
-	//printf("Merging existing %d with new %d\n", soln, subsoln);
+      for (int subsoln = 1; subsoln <= subsolns[i].Length(); subsoln++) {
 	DVector<T> bp(thissolns[soln]);
-	DVector<T> tmp(subsolns[subsoln]);
+	DVector<T> tmp(subsolns[i][subsoln]);
 	for (int j = 1; j <= bp.Length(); j++) {
 	  bp[j] += tmp[j];
 	}
 	newsolns.Append(bp);
 	
 	newsubrootvalues.Append(subrootvalues[soln]);
-	newsubrootvalues[newsubrootvalues.Length()][i] = subvalues[subsoln];
+	newsubrootvalues[newsubrootvalues.Length()][i] = outcomes[subsoln];
       }
     }
     
     thissolns = newsolns;
     subrootvalues = newsubrootvalues;
-    //printf("Finished solving subgame %d\n", i);
   }
   
+  Vector<T> rootval(p_game->NumPlayers());
+  rootval = T(0);
+  if (n->GetOutcome()) {
+    for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+      rootval[pl] = n->GetOutcome()->GetPayoff<T>(pl);
+    }
+  }
+
   for (int soln = 1; soln <= thissolns.Length(); soln++)   {
-    //printf("Analyzing scenario %d of %d\n", soln, thissolns.Length());
     for (int i = 1; i <= subroots.Length(); i++) {
       subroots[i]->SetOutcome(subrootvalues[soln][i]);
     }
-    
-    Game subgame = n->CopySubgame();
-    // this prevents double-counting of outcomes at roots of subgames
-    // by convention, we will just put the payoffs in the parent subgame
-    subgame->GetRoot()->SetOutcome(0);
-
-    BehaviorSupportProfile subsupport(subgame);
-    // Here, we build the support for the subgame
-    /*
-    for (int pl = 1; pl <= subgame->NumPlayers(); pl++)  {
-      GamePlayer subplayer = subgame->GetPlayer(pl);
-      GamePlayer player = p_support.GetGame()->GetPlayer(pl);
-
-      for (int iset = 1; iset <= subplayer->NumInfosets(); iset++) {
-	GameInfoset subinfoset = subplayer->GetInfoset(iset);
-
-	for (int j = 1; j <= player->NumInfosets(); j++) {
-	  GameInfoset infoset = player->GetInfoset(j);
-	  if (subinfoset->GetLabel() == infoset->GetLabel()) {
-	    for (int act = 1; act <= infoset->NumActions(); act++)  {
-	      if (!p_support.Contains(infoset->GetAction(act))) {
-		subsupport.RemoveAction(subinfoset->GetAction(act));
-	      }
-	    }
-	    break;
+
+    std::string key;
+    Array<List<GameInfoset> > infosets(p_game->NumPlayers());
+    std::map<GameInfosetRep *, int> indices;
+    SubgameKey(n, true, key, infosets, indices);
+
+    SubgameSolutions<T> sol;
+    if (!m_cache.Find(key, sol)) {
+      try {
+	Game subgame = n->CopySubgame();
+	// this prevents double-counting of outcomes at roots of subgames
+	// by convention, we will just put the payoffs in the parent subgame
+	subgame->GetRoot()->SetOutcome(0);
+
+	BehaviorSupportProfile subsupport(subgame);
+	List<MixedBehaviorProfile<T> > profiles = m_solver.Solve(subsupport);
+	for (int solno = 1; solno <= profiles.Length(); solno++) {
+	  Vector<T> probs(profiles[solno].Length());
+	  for (int j = 1; j <= probs.Length(); j++) {
+	    probs[j] = profiles[solno][j];
 	  }
+	  sol.m_profiles.Append(probs);
+	  Vector<T> payoffs(subgame->NumPlayers());
+	  for (int pl = 1; pl <= subgame->NumPlayers(); pl++) {
+	    payoffs[pl] = profiles[solno].GetPayoff(pl);
+	  }
+	  sol.m_payoffs.Append(payoffs);
 	}
       }
+      catch (...) {
+	m_cache.Abandon(key);
+	throw;
+      }
+      m_cache.Insert(key, sol);
     }
-    */
 
-    List<MixedBehaviorProfile<T> > sol = m_solver->Solve(subsupport);
-    
-    if (sol.Length() == 0)  {
+    if (sol.m_profiles.Length() == 0)  {
       solns = List<DVector<T> >();
-      //printf("No solutions found\n");
       return;
     }
     
     // Put behavior profile in "total" solution here...
-    for (int solno = 1; solno <= sol.Length(); solno++)  {
+    for (int solno = 1; solno <= sol.m_profiles.Length(); solno++)  {
       solns.Append(thissolns[soln]);
-      
-      for (int pl = 1; pl <= subgame->NumPlayers(); pl++)  {
-	GamePlayer subplayer = subgame->GetPlayer(pl);
-	GamePlayer player = p_support.GetGame()->GetPlayer(pl);
-
-	for (int iset = 1; iset <= subplayer->NumInfosets(); iset++) {
-	  GameInfoset subinfoset = subplayer->GetInfoset(iset);
-
-	  for (int j = 1; j <= player->NumInfosets(); j++) {
-	    if (subinfoset->GetLabel() == player->GetInfoset(j)->GetLabel()) {
-	      int id = atoi(subinfoset->GetLabel().c_str());
-	      for (int act = 1; act <= subsupport.NumActions(pl, iset); act++) {
-		int actno = subsupport.GetAction(pl, iset, act)->GetNumber();
-		solns[solns.Length()](pl, id, actno) = sol[solno](pl, iset, act);	  
-	      }
-	      break;
-	    }
+      const Vector<T> &probs = sol.m_profiles[solno];
+      int index = 1;
+      for (int pl = 1; pl <= infosets.Length(); pl++)  {
+	for (int iset = 1; iset <= infosets[pl].Length(); iset++) {
+	  GameInfoset infoset = infosets[pl][iset];
+	  int id = p_ids.find(infoset)->second;
+	  for (int act = 1; act <= infoset->NumActions(); act++) {
+	    solns[solns.Length()](pl, id, act) = probs[index++];
 	  }
 	}
       }
-      
-      Vector<T> subval(subgame->NumPlayers());
-      GameOutcome outcome = n->GetOutcome();
-      for (int pl = 1; pl <= subgame->NumPlayers(); pl++)  {
-	subval[pl] = sol[solno].GetPayoff(pl);
-	if (outcome) {
-	  subval[pl] += outcome->GetPayoff<T>(pl);
-        }
-      }
 
-      GameOutcome ov = efg->NewOutcome();
-      for (int pl = 1; pl <= efg->NumPlayers(); pl++) {
-	ov->SetPayoff(pl, lexical_cast<std::string>(subval[pl]));
-      }
- 
-      values.Append(ov);
+      Vector<T> subval(sol.m_payoffs[solno]);
+      subval += rootval;
+      values.Append(subval);
     }
-    //printf("Finished with scenario %d of %d; total solutions so far = %d\n",
-    //soln, thissolns.Length(), solns.Length());
   }
-
-  n->DeleteTree();
 }
 
+} // end nested anonymous namespace
+
 template <class T>
 List<MixedBehaviorProfile<T> > 
 SubgameBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 {
-  Game efg = p_support.GetGame()->GetRoot()->CopySubgame();
+  Array<Array<GameInfoset> > infosets;
+  Game efg = p_support.GetGame()->GetRoot()->CopySubgame(infosets);
 
+  std::map<GameInfosetRep *, int> ids;
   for (int pl = 1; pl <= efg->NumPlayers(); pl++) {
     for (int iset = 1; iset <= efg->GetPlayer(pl)->NumInfosets(); iset++) {
-      efg->GetPlayer(pl)->GetInfoset(iset)->SetLabel(lexical_cast<std::string>(iset));
+      ids[efg->GetPlayer(pl)->GetInfoset(iset)] = iset;
     }
   }
 
@@ -439,10 +622,11 @@ SubgameBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
     }
   }
 
+  DVector<T> templateSolution(support.NumActions());
+  SubgameDecomposition<T> decomposition(*m_solver, templateSolution);
   List<DVector<T> > vectors;
-  List<GameOutcome> values;
-  SolveSubgames(support, DVector<T>(support.NumActions()),
-		efg->GetRoot(), vectors, values);
+  List<Vector<T> > values;
+  decomposition.Solve(efg, ids, m_numThreads, vectors, values);
 
   List<MixedBehaviorProfile<T> > solutions;
   for (int i = 1; i <= vectors.Length(); i++) {
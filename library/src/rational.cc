@@ -49,6 +49,7 @@ void Rational::normalize(void)
     num.negate();
   }
 
+  if (den == 1L) return;
   Integer g = gcd(num, den);
   if (ucompare(g, _Int_One) != 0)  {
     num /= g;
@@ -390,15 +391,12 @@ Rational::fits_in_double() const
 // These were moved from the header file to eliminate warnings
 //
 
-static IntegerRep _ZeroRep = {1, 0, 1, {0}};
-static IntegerRep _OneRep = {1, 0, 1, {1}};
-
-Rational::Rational() : num(&_ZeroRep), den(&_OneRep) {}
+Rational::Rational() : num(0L), den(1L) {}
 Rational::~Rational() {}
 
 Rational::Rational(const Rational& y) :num(y.num), den(y.den) {}
 
-Rational::Rational(const Integer& n) :num(n), den(&_OneRep) {}
+Rational::Rational(const Integer& n) :num(n), den(1L) {}
 
 Rational::Rational(const Integer& n, const Integer& d) 
  : num(n), den(d)
@@ -409,9 +407,9 @@ Rational::Rational(const Integer& n, const Integer& d)
   normalize();
 }
 
-Rational::Rational(long n) :num(n), den(&_OneRep) { }
+Rational::Rational(long n) :num(n), den(1L) { }
 
-Rational::Rational(int n) :num(n), den(&_OneRep) { }
+Rational::Rational(int n) :num(n), den(1L) { }
 
 Rational::Rational(long n, long d) 
  : num(n), den(d)
@@ -537,9 +535,57 @@ Rational Rational::operator/(const Rational &y) const
 }
 
 
+namespace {
+
+/// Converts the common case of a short integer, decimal or fraction,
+/// whose numerator and denominator fit in a long, without using
+/// Integer arithmetic.  Returns false if p_text is not of this form.
+bool ParseShortRational(const std::string &p_text, Rational &p_value)
+{
+  const int maxDigits = 9;
+  const char *c = p_text.c_str();
+  bool negative = (*c == '-');
+  if (negative)  c++;
+
+  long num = 0, denom = 1;
+  int digits = 0;
+  for (; *c >= '0' && *c <= '9'; c++) {
+    if (++digits > maxDigits)  return false;
+    num = 10 * num + (*c - '0');
+  }
+  if (*c == '.') {
+    for (c++; *c >= '0' && *c <= '9'; c++) {
+      if (++digits > maxDigits)  return false;
+      num = 10 * num + (*c - '0');
+      denom *= 10;
+    }
+  }
+  else if (*c == '/') {
+    int denomDigits = 0;
+    denom = 0;
+    for (c++; *c >= '0' && *c <= '9'; c++) {
+      if (++denomDigits > maxDigits)  return false;
+      denom = 10 * denom + (*c - '0');
+    }
+    if (denom == 0)  return false;
+  }
+  if (digits == 0 || *c != '\0')  return false;
+
+  if (negative)  num = -num;
+  p_value = (denom == 1) ? Rational(num) : Rational(num, denom);
+  return true;
+}
+
+}  // end anonymous namespace
+
 template<>
 Rational lexical_cast(const std::string &f)
 {
+  Rational value;
+  if (ParseShortRational(f, value)) {
+    return value;
+  }
+
   char ch = ' ';
   int sign = 1;
   unsigned int index = 0, length = f.length();
@@ -398,11 +398,12 @@ NashSimpdivStrategySolver::State::getlabel(MixedStrategyProfile<Rational> &yy,
   
   for (int i = 1; i <= yy.GetGame()->NumPlayers(); i++) {
     GamePlayer player = yy.GetGame()->Players()[i];
+    Vector<Rational> values = yy.GetPayoffVector(player);
     Rational payoff = 0;
     Rational maxval = -1000000;
     int jj = 0;
     for (size_t j = 1; j <= player->Strategies().size(); j++) {
-      pay = yy.GetPayoff(player->Strategies()[j]);
+      pay = values[j];
       payoff += yy[player->Strategies()[j]] * pay;
       if (pay > maxval) {
 	maxval = pay;
@@ -22,6 +22,7 @@
 
 #include "gambit/gambit.h"
 #include "gambit/gametable.h"
+#include "gambit/outbuf.h"
 
 namespace Gambit {
 
@@ -99,44 +100,27 @@ bool StrategySupportProfile::IsSubsetOf(const StrategySupportProfile &p_support)
   return true;
 }
 
-
-namespace {
-
-std::string EscapeQuotes(const std::string &s)
-{
-  std::string ret;
-  
-  for (unsigned int i = 0; i < s.length(); i++)  {
-    if (s[i] == '"')   ret += '\\';
-    ret += s[i];
-  }
-
-  return ret;
-}
-
-}  // end anonymous namespace
-
-
 void StrategySupportProfile::WriteNfgFile(std::ostream &p_file) const
 { 
-  p_file << "NFG 1 R";
-  p_file << " \"" << EscapeQuotes(m_nfg->GetTitle()) << "\" { ";
+  OutputBuffer out(p_file);
+  out << "NFG 1 R ";
+  out.Quoted(m_nfg->GetTitle()) << " { ";
 
   for (int i = 1; i <= m_nfg->NumPlayers(); i++)
-    p_file << '"' << EscapeQuotes(m_nfg->GetPlayer(i)->GetLabel()) << "\" ";
+    out.Quoted(m_nfg->GetPlayer(i)->GetLabel()) << ' ';
 
-  p_file << "}\n\n{ ";
+  out << "}\n\n{ ";
   
   for (int i = 1; i <= m_nfg->NumPlayers(); i++)   {
-    p_file << "{ ";
+    out << "{ ";
     for (int j = 1; j <= NumStrategies(i); j++)
-      p_file << '"' << EscapeQuotes(GetStrategy(i, j)->GetLabel()) << "\" ";
-    p_file << "}\n";
+      out.Quoted(GetStrategy(i, j)->GetLabel()) << ' ';
+    out << "}\n";
   }
   
-  p_file << "}\n";
+  out << "}\n";
 
-  p_file << "\"" << EscapeQuotes(m_nfg->GetComment()) << "\"\n\n";
+  out.Quoted(m_nfg->GetComment()) << "\n\n";
 
   // For trees, we write the payoff version, since there need not be
   // a one-to-one correspondence between outcomes and entries, when there
@@ -145,12 +129,12 @@ void StrategySupportProfile::WriteNfgFile(std::ostream &p_file) const
     
   for (; !iter.AtEnd(); iter++) {
     for (int pl = 1; pl <= m_nfg->NumPlayers(); pl++) {
-      p_file << (*iter)->GetPayoff(pl) << " ";
+      out << (*iter)->GetPayoff(pl) << ' ';
     }
-    p_file << "\n";
+    out << '\n';
   }
 
-  p_file << '\n';
+  out << '\n';
 }
 
 //---------------------------------------------------------------------------
@@ -392,19 +376,41 @@ bool StrategySupportProfile::Overwhelms(const GameStrategy &s,
 
 Game StrategySupportProfile::Restrict(void) const
 {
-  std::ostringstream os;
-  WriteNfgFile(os);
-  std::istringstream is(os.str());
-  Game restricted = ReadGame(is);
-  for (int pl = 1; pl <= restricted->NumPlayers(); pl++) {
-    GamePlayerRep *player = restricted->Players()[pl];
+  // The restriction has one outcome per contingency, as when written
+  // in payoff format, since for trees there need not be a one-to-one
+  // correspondence between outcomes and contingencies.
+  GameTableRep *nfg = new GameTableRep(NumStrategies());
+  Game restricted = nfg;
+  nfg->SetTitle(m_nfg->GetTitle());
+  nfg->SetComment(m_nfg->GetComment());
+  for (int pl = 1; pl <= nfg->NumPlayers(); pl++) {
+    GamePlayerRep *player = nfg->m_players[pl];
+    player->m_label = m_nfg->Players()[pl]->m_label;
     player->m_unrestricted = m_nfg->Players()[pl];
     for (int st = 1; st <= player->NumStrategies(); st++) {
       GameStrategyRep *strategy = player->m_strategies[st];
-      strategy->m_unrestricted = m_nfg->Players()[pl]->Strategies()[st];
+      strategy->m_label = GetStrategy(pl, st)->m_label;
+      strategy->m_unrestricted = GetStrategy(pl, st);
+    }
+  }
+
+  // Payoffs of table games are copied as entered; otherwise, they are
+  // computed for each contingency
+  bool isTable = (dynamic_cast<GameTableRep *>(&(*m_nfg)) != 0);
+  StrategySupportProfile full(restricted);
+  StrategyProfileIterator iter(*this), dest(full);
+  for (; !iter.AtEnd(); iter++, dest++) {
+    GameOutcomeRep *outcome = (*dest)->GetOutcome();
+    if (!isTable) {
+      for (int pl = 1; pl <= nfg->NumPlayers(); pl++) {
+	outcome->m_payoffs[pl] = Number((*iter)->GetPayoff(pl));
+      }
+    }
+    else if ((*iter)->GetOutcome()) {
+      outcome->m_payoffs = (*iter)->GetOutcome()->m_payoffs;
     }
   }
-  dynamic_cast<GameTableRep &>(*restricted).m_unrestricted = m_nfg;
+  nfg->m_unrestricted = m_nfg;
   return restricted;
 }
 
@@ -68,6 +68,10 @@ void PrintHelp(char *progname)
   std::cerr << "  -D               don't eliminate dominated strategies first\n";
   std::cerr << "  -L               use lrslib for enumeration (experimental!)\n";
   std::cerr << "  -c               output connectedness information\n";
+  std::cerr << "  -j THREADS       match vertices on THREADS threads (0 for one per\n";
+  std::cerr << "                   processor)\n";
+  std::cerr << "  -m               keep only the smaller vertex set in memory,\n";
+  std::cerr << "                   reporting equilibria as they are found\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -78,8 +82,8 @@ int main(int argc, char *argv[])
 {
   int c;
   bool useFloat = false, uselrs = false, quiet = false, eliminate = true;
-  bool showConnect = false;
-  int numDecimals = 6;
+  bool showConnect = false, useStream = false;
+  int numDecimals = 6, numThreads = 1;
   int long_opt_index = 0;
   int optind = argc - 1;
   for (int i = 1; i < argc; i++)
@@ -107,6 +111,12 @@ int main(int argc, char *argv[])
     case 'c':
       showConnect = true;
       break;
+    case 'j':
+      numThreads = atoi(optarg);
+      break;
+    case 'm':
+      useStream = true;
+      break;
     case 'S':
       break;
     case 'q':
@@ -132,7 +142,7 @@ int main(int argc, char *argv[])
   std::istream* input_stream = &std::cin;
   std::ifstream file_stream;
   if (optind < argc) {
-    file_stream.open(argv[optind]);
+    file_stream.open(argv[optind], std::ios::binary);
     if (!file_stream.is_open()) {
       std::ostringstream error_message;
       error_message << argv[0] << ": " << argv[optind];
@@ -154,7 +164,7 @@ int main(int argc, char *argv[])
       shared_ptr<StrategyProfileRenderer<double> > renderer;
       renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 						      numDecimals);
-      EnumMixedStrategySolver<double> solver(renderer);
+      EnumMixedStrategySolver<double> solver(renderer, numThreads, useStream);
       shared_ptr<EnumMixedStrategySolution<double> > solution =
 	solver.SolveDetailed(game);
       if (showConnect) {
@@ -166,7 +176,7 @@ int main(int argc, char *argv[])
     else {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
       renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
-      EnumMixedStrategySolver<Rational> solver(renderer);
+      EnumMixedStrategySolver<Rational> solver(renderer, numThreads, useStream);
       shared_ptr<EnumMixedStrategySolution<Rational> > solution =
 	solver.SolveDetailed(game);
       if (showConnect) {
@@ -27,6 +27,7 @@
 using namespace Gambit;
 
 #include "efgensup.h"
+#include "supportqueue.h"
 #include "sfg.h"
 #include "gpoly.h"
 #include "gpolylst.h"
@@ -386,29 +387,42 @@ void PrintSupport(std::ostream &p_stream,
   p_stream << std::endl;
 }
 
-void SolveExtensive(const Game &p_game)
-{
-  List<BehaviorSupportProfile> supports = PossibleNashSubsupports(p_game);
+namespace {
 
-  for (int i = 1; i <= supports.Length(); i++) {
+/// Solves the polynomial system of a single support, writing the
+/// equilibria found, and in verbose mode the support itself
+class ExtensiveSupportSolver {
+public:
+  void operator()(const BehaviorSupportProfile &p_support,
+		  std::ostream &p_stream) const
+  {
     if (g_verbose) {
-      PrintSupport(std::cout, "candidate", supports[i]);
+      PrintSupport(p_stream, "candidate", p_support);
     }
       
     bool isSingular = false;
     List<MixedBehaviorProfile<double> > newsolns = 
-      SolveSupport(supports[i], isSingular);
+      SolveSupport(p_support, isSingular);
 
     for (int j = 1; j <= newsolns.Length(); j++) {
       MixedBehaviorProfile<double> fullProfile = ToFullSupport(newsolns[j]);
       if (fullProfile.GetLiapValue(true) < 1.0e-6) {
-	PrintProfile(std::cout, "NE", fullProfile);
+	PrintProfile(p_stream, "NE", fullProfile);
       }
     }
       
     if (isSingular && g_verbose) {
-      PrintSupport(std::cout, "singular", supports[i]);
+      PrintSupport(p_stream, "singular", p_support);
     }
   }
+};
+
+}  // end anonymous namespace
+
+void SolveExtensive(const Game &p_game, int p_stopAfter, int p_numThreads)
+{
+  List<BehaviorSupportProfile> supports = PossibleNashSubsupports(p_game);
+  ExtensiveSupportSolver solver;
+  SolveSupports(supports, solver, p_stopAfter, p_numThreads);
 }
 
@@ -53,6 +53,10 @@ void PrintHelp(char *progname)
   std::cerr << "  -S               use strategic game\n";
   std::cerr << "  -H               use heuristic search method to optimize time\n";
   std::cerr << "                   to find first equilibrium (strategic games only)\n";
+  std::cerr << "  -e EQA           terminate after finding EQA equilibria\n";
+  std::cerr << "  -j THREADS       solve supports in parallel on THREADS threads\n";
+  std::cerr << "                   (0 for one per processor); with -H, search\n";
+  std::cerr << "                   for the roots of each system in parallel\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows supports investigated)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -60,13 +64,14 @@ void PrintHelp(char *progname)
   exit(1);
 }
 
-extern void SolveStrategic(const Gambit::Game &);
-extern void SolveExtensive(const Gambit::Game &);
+extern void SolveStrategic(const Gambit::Game &, int p_stopAfter, int p_numThreads);
+extern void SolveExtensive(const Gambit::Game &, int p_stopAfter, int p_numThreads);
 
 int main(int argc, char *argv[])
 {
   bool quiet = false;
   bool useHeuristic = false, useStrategic = false;
+  int stopAfter = 0, numThreads = -1;
 
   int long_opt_index = 0;
   int optind = argc - 1;
@@ -85,6 +90,12 @@ int main(int argc, char *argv[])
     case 'h':
       PrintHelp(argv[0]);
       break;
+    case 'e':
+      stopAfter = atoi(optarg);
+      break;
+    case 'j':
+      numThreads = atoi(optarg);
+      break;
     case 'H':
       useHeuristic = true;
       break;
@@ -117,7 +128,7 @@ int main(int argc, char *argv[])
   std::istream* input_stream = &std::cin;
   std::ifstream file_stream;
   if (optind < argc) {
-    file_stream.open(argv[optind]);
+    file_stream.open(argv[optind], std::ios::binary);
     if (!file_stream.is_open()) {
       std::ostringstream error_message;
       error_message << argv[0] << ": " << argv[optind];
@@ -132,18 +143,21 @@ int main(int argc, char *argv[])
     if (!game->IsPerfectRecall()) {
       throw Gambit::UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
     }
+    if (numThreads >= 0) {
+      game->Freeze();
+    }
 
     if (!game->IsTree() || useStrategic) {
       if (useHeuristic) {
-	gbtNfgHs algorithm(0);
+	gbtNfgHs algorithm(stopAfter, (numThreads >= 0) ? numThreads : 1);
 	algorithm.Solve(game);
       }
       else {
-	SolveStrategic(game);
+	SolveStrategic(game, stopAfter, (numThreads >= 0) ? numThreads : 1);
       }
     }
     else {
-      SolveExtensive(game);
+      SolveExtensive(game, stopAfter, (numThreads >= 0) ? numThreads : 1);
     }
     return 0;
   }
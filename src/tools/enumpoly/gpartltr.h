@@ -28,6 +28,7 @@
 #include "rectangl.h"
 #include "gpoly.h"
 #include "gpolylst.h"
+#include "gpolycmp.h"
 
 // ****************************
 //      class TreeOfPartials
@@ -36,6 +37,7 @@
 template <class T> class TreeOfPartials {
 private:
   gTree<gPoly<T> > PartialTree;
+  gCompiledPoly<T> CompiledRoot;
 
   /// Recursive Constructions and Computations ///
 
@@ -77,7 +79,7 @@ public:
 
    inline gTreeNode<gPoly<T> >* RootNode()                     const 
      { return PartialTree.RootNode(); }
-   inline gPoly<T> RootPoly()                                  const 
+   inline const gPoly<T> &RootPoly()                           const 
      { return RootNode()->GetData(); }
    T ValueOfRootPoly(const Gambit::Vector<T>& point)           const;
    T ValueOfPartialOfRootPoly(const int&, const Gambit::Vector<T>&)   const;
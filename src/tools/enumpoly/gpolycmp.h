@@ -0,0 +1,129 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/enumpoly/gpolycmp.h
+// Compiled polynomials for fast repeated evaluation
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GPOLYCMP_H
+#define GPOLYCMP_H
+
+#include <vector>
+#include "gambit/gambit.h"
+#include "gpoly.h"
+#include "gpolylst.h"
+
+/*
+   A gPoly stores its terms as a list of monomials, each with its own
+exponent vector, which suits the algebra done on polynomials but makes
+evaluation slow: each term is visited through the list, and each
+variable is multiplied in once per unit of its exponent.  The solvers
+evaluate the same polynomials, and their partial derivatives, at a
+great many points.  The classes here hold a "compiled" copy of a
+polynomial for that purpose.  The coefficients are stored in a flat
+array, and the exponents as a flat array of (variable, exponent)
+pairs, listing only the variables that occur in each term.  The powers
+of the coordinates of a point are computed once, in a gPowerTable,
+and shared by all the terms and polynomials evaluated at that point.
+The value and the gradient of a polynomial are computed in a single
+pass over its terms.
+*/
+
+
+// ***********************
+//    class gPowerTable
+// ***********************
+
+template <class T> class gPowerTable {
+private:
+  std::vector<int> m_offsets;
+  std::vector<T> m_powers;
+
+public:
+  // Holds the powers of each variable i up to p_degrees[i]
+  gPowerTable(const Gambit::Array<int> &p_degrees);
+
+  void SetPoint(const Gambit::Vector<T> &);
+
+  // The p_exp'th power of the p_var'th coordinate of the point
+  const T &operator()(int p_var, int p_exp) const
+    { return m_powers[m_offsets[p_var - 1] + p_exp]; }
+};
+
+
+// ***********************
+//   class gCompiledPoly
+// ***********************
+
+template <class T> class gCompiledPoly {
+private:
+  int m_dmnsn;
+  std::vector<T> m_coefs;
+  // The factors of term t are m_vars[k], m_exps[k] for
+  // m_starts[t] <= k < m_starts[t+1]
+  std::vector<int> m_starts, m_vars, m_exps;
+  Gambit::Array<int> m_degrees;
+  int m_maxFactors;
+
+public:
+  gCompiledPoly(const gPoly<T> &);
+
+  int Dmnsn(void) const { return m_dmnsn; }
+  int NumTerms(void) const { return m_coefs.size(); }
+  // The highest power of each variable appearing in the polynomial
+  const Gambit::Array<int> &Degrees(void) const { return m_degrees; }
+  int MaxFactors(void) const { return m_maxFactors; }
+
+  T Evaluate(const gPowerTable<T> &) const;
+  T Evaluate(const Gambit::Vector<T> &) const;
+  // Returns the value at the point, and sets p_gradient to the vector
+  // of partial derivatives there.  p_scratch must have room for
+  // MaxFactors() + 1 entries.
+  T EvaluateWithGradient(const gPowerTable<T> &,
+			 Gambit::Vector<T> &p_gradient, T *p_scratch) const;
+};
+
+
+// ***************************
+//   class gCompiledPolyList
+// ***************************
+
+template <class T> class gCompiledPolyList {
+private:
+  int m_dmnsn;
+  std::vector<gCompiledPoly<T> > m_polys;
+  Gambit::Array<int> m_degrees;
+  int m_maxFactors;
+
+public:
+  gCompiledPolyList(const gPolyList<T> &);
+
+  int Length(void) const { return m_polys.size(); }
+  int Dmnsn(void) const { return m_dmnsn; }
+  const gCompiledPoly<T> &operator[](int i) const { return m_polys[i - 1]; }
+
+  // The values of the first p_count polynomials at the point
+  Gambit::Vector<T> Evaluate(const Gambit::Vector<T> &, int p_count) const;
+  // The values of the first p_count polynomials at the point, and the
+  // matrix of their partial derivatives, with one row per polynomial
+  void EvaluateWithDerivatives(const Gambit::Vector<T> &, int p_count,
+			       Gambit::Vector<T> &p_values,
+			       Gambit::Matrix<T> &p_derivs) const;
+};
+
+#endif // GPOLYCMP_H
@@ -28,8 +28,9 @@
 //              HeuristicPolEnumModule: Member functions
 //-------------------------------------------------------------------------
 
-HeuristicPolEnumModule::HeuristicPolEnumModule(const StrategySupportProfile &S, int p_stopAfter)
-  : m_stopAfter(p_stopAfter), NF(S.GetGame()), support(S),
+HeuristicPolEnumModule::HeuristicPolEnumModule(const StrategySupportProfile &S, int p_stopAfter,
+					       int p_numThreads)
+  : m_stopAfter(p_stopAfter), m_numThreads(p_numThreads), NF(S.GetGame()), support(S),
     Space(support.MixedProfileLength()-NF->NumPlayers()), 
     Lex(&Space, lex), num_vars(support.MixedProfileLength()-NF->NumPlayers()), 
     nevals(0), is_singular(false)
@@ -210,7 +211,7 @@ HeuristicPolEnumModule::NashOnSupportSolnVectors(const gPolyList<double> &equati
   //  p_status.SetProgress(0);
 
   try {
-    quickie.FindCertainNumberOfRoots(Cube,2147483647, m_stopAfter);
+    quickie.FindCertainNumberOfRoots(Cube,2147483647, m_stopAfter, m_numThreads);
   }
   catch (SingularMatrixException) {
     is_singular = true;
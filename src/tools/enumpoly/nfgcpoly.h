@@ -36,7 +36,7 @@ using namespace Gambit;
 
 class HeuristicPolEnumModule  {
 private:
-  int m_stopAfter;
+  int m_stopAfter, m_numThreads;
   double eps;
   Game NF;
   const StrategySupportProfile &support;
@@ -65,7 +65,9 @@ private:
 
   int SaveSolutions(const Gambit::List<Vector<double> > &list);
 public:
-  HeuristicPolEnumModule(const StrategySupportProfile &, int p_stopAfter);
+  // The roots of each system are searched for on p_numThreads threads
+  HeuristicPolEnumModule(const StrategySupportProfile &, int p_stopAfter,
+			 int p_numThreads = 1);
   
   int PolEnum(void);
   
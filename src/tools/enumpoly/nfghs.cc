@@ -134,8 +134,8 @@ void gbtNfgHs::Cleanup(Game game) {
 }
 
 
-gbtNfgHs::gbtNfgHs(int p_stopAfter) 
-  : m_iteratedRemoval(true), m_removalWhenUninstantiated(1),
+gbtNfgHs::gbtNfgHs(int p_stopAfter, int p_numThreads) 
+  : m_numThreads(p_numThreads), m_iteratedRemoval(true), m_removalWhenUninstantiated(1),
     m_ordering("automatic")
 #ifdef DEBUG
   , m_logfile(std::cerr)
@@ -679,7 +679,8 @@ bool gbtNfgHs::FeasibilityProgram(Game game,
   }
      
   Gambit::List < MixedStrategyProfile < double > > newSolutions;
-  HeuristicPolEnumModule module(restrictedGame, (m_stopAfter == 1) ? 1 : 0);
+  HeuristicPolEnumModule module(restrictedGame, (m_stopAfter == 1) ? 1 : 0,
+				m_numThreads);
   module.PolEnum();
   newSolutions = module.GetSolutions();
 
@@ -32,7 +32,7 @@ using namespace Gambit;
 
 class gbtNfgHs {
 private:
-  int m_stopAfter;
+  int m_stopAfter, m_numThreads;
   bool m_iteratedRemoval;
   int m_removalWhenUninstantiated;
   std::string m_ordering;
@@ -88,7 +88,7 @@ private:
 
 
 public:
-  gbtNfgHs(int = 1);
+  gbtNfgHs(int = 1, int = 1);
 
   virtual ~gbtNfgHs() {
   }
@@ -101,6 +101,14 @@ public:
     m_stopAfter = p_stopAfter;
   }
 
+  int NumThreads(void)const {
+    return m_numThreads;
+  }
+
+  void SetNumThreads(int p_numThreads) {
+    m_numThreads = p_numThreads;
+  }
+
   bool IteratedRemoval(void)const {
     return m_iteratedRemoval;
   }
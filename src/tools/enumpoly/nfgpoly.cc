@@ -25,6 +25,7 @@
 #include <iomanip>
 
 #include "nfgensup.h"
+#include "supportqueue.h"
 #include "gpoly.h"
 #include "gpolylst.h"
 #include "rectangl.h"
@@ -478,33 +479,46 @@ void PrintSupport(std::ostream &p_stream,
   p_stream << std::endl;
 }
 
-void SolveStrategic(const Gambit::Game &p_nfg)
-{
-  Gambit::List<Gambit::StrategySupportProfile> supports = PossibleNashSubsupports(p_nfg);
+namespace {
 
-  for (int i = 1; i <= supports.Length(); i++) {
+/// Solves the polynomial system of a single support, writing the
+/// equilibria found, and in verbose mode the support itself
+class StrategicSupportSolver {
+public:
+  void operator()(const Gambit::StrategySupportProfile &p_support,
+		  std::ostream &p_stream) const
+  {
     long newevals = 0;
     double newtime = 0.0;
     Gambit::List<Gambit::MixedStrategyProfile<double> > newsolns;
     bool is_singular = false;
     
     if (g_verbose) {
-      PrintSupport(std::cout, "candidate", supports[i]);
+      PrintSupport(p_stream, "candidate", p_support);
     }
 
-    PolEnum(supports[i], newsolns, newevals, newtime, is_singular);
+    PolEnum(p_support, newsolns, newevals, newtime, is_singular);
       
     for (int j = 1; j <= newsolns.Length(); j++) {
       Gambit::MixedStrategyProfile<double> fullProfile = ToFullSupport(newsolns[j]);
       if (fullProfile.GetLiapValue() < 1.0e-6) {
-	PrintProfile(std::cout, "NE", fullProfile);
+	PrintProfile(p_stream, "NE", fullProfile);
       }
     }
 
     if (is_singular && g_verbose) {
-      PrintSupport(std::cout, "singular", supports[i]);
+      PrintSupport(p_stream, "singular", p_support);
     }
   }
+};
+
+}  // end anonymous namespace
+
+void SolveStrategic(const Gambit::Game &p_nfg, int p_stopAfter, int p_numThreads)
+{
+  Gambit::List<Gambit::StrategySupportProfile> supports = PossibleNashSubsupports(p_nfg);
+  StrategicSupportSolver solver;
+  SolveSupports(supports, solver, p_stopAfter, p_numThreads);
 }
 
 
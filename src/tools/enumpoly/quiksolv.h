@@ -23,12 +23,17 @@
 #ifndef QUIKSOLV_H
 #define QUIKSOLV_H
 
+#include <map>
+#include <memory>
+#include <unordered_map>
 #include "gambit/gambit.h"
+#include "gambit/parallel.h"
 #include "odometer.h"
 #include "gsolver.h"
 #include "rectangl.h"
 #include "gpoly.h"
 #include "gpolylst.h"
+#include "gpolycmp.h"
 #include "gpartltr.h"
 #include "pelqhull.h"
 #include "pelclass.h"
@@ -48,6 +53,11 @@ each.  This continues until it has been shown that all roots have been
 found, or a predetermined search depth is reached.  The bound on depth
 is necessary because the procedure will not terminate if there are
 singular roots.
+
+    The subdivided rectangles are independent of each other, and may
+be searched on several threads.  The roots are reported in the order
+in which a depth-first search of the subdivision finds them, whatever
+the number of threads.
 */
 
 /*
@@ -63,10 +73,15 @@ sense that the polynomial is required to be nonnegative.
 //      class QuikSolv
 // ***********************
 
+template <class T> class QuikSolvRootSearch;
+
 template <class T> class QuikSolv {
+  friend class QuikSolvRootSearch<T>;
+
  private:
   const gPolyList<T>                 System;
   const gPolyList<double>           gDoubleSystem;
+  const gCompiledPolyList<double>   CompiledSystem;
   const int                          NoEquations;
   const int                          NoInequalities;
   const ListOfPartialTrees<double>  TreesOfPartials;
@@ -120,15 +135,6 @@ template <class T> class QuikSolv {
 
   // Recursive parts of recursive methods
 
-  void               FindRootsRecursion(      Gambit::List<Gambit::Vector<double> >*,
-					const gRectangle<double>&, 
-					const int&,
-					      Gambit::Array<int>&,
-					      int &iterations,
-					      int depth,
-					const int&,
-					      int*)                  const;
-
   const bool         ARootExistsRecursion(const gRectangle<double>&, 
 					        Gambit::Vector<double>&,
 					  const gRectangle<double>&, 
@@ -175,11 +181,14 @@ template <class T> class QuikSolv {
   // Checks for complex singular roots
    bool     MightHaveSingularRoots()                                 const;
 
-  // The grand calculation - returns true if successful
+  // The grand calculation - returns true if successful.
+  // The search uses up to p_numThreads threads (see NumWorkerThreads()).
    bool     FindCertainNumberOfRoots  (const gRectangle<T>&, 
 				       const int&,
-				       const int&);
-   bool     FindRoots  (const gRectangle<T>&, const int&);
+				       const int&,
+				       int p_numThreads = 1);
+   bool     FindRoots  (const gRectangle<T>&, const int&,
+			int p_numThreads = 1);
    bool     ARootExists (const gRectangle<T>&, Gambit::Vector<double>&)    const;
 };  
 
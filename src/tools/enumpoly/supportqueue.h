@@ -0,0 +1,129 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/enumpoly/supportqueue.h
+// Solving a list of supports on a pool of threads
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef SUPPORTQUEUE_H
+#define SUPPORTQUEUE_H
+
+#include <iostream>
+#include <sstream>
+#include <mutex>
+#include "gambit/gambit.h"
+#include "gambit/parallel.h"
+
+//
+// Solves each of a list of supports, with the supports handed out to
+// threads from a WorkQueue.  The polynomial system of each support is
+// independent of the others, so the supports may be solved in any
+// order; the output for each support is buffered, and written once the
+// output for all earlier supports has been written, so that the output
+// does not depend on the number of threads.  Once p_stopAfter
+// equilibria (lines starting "NE,") have been written, if p_stopAfter
+// is positive, the remaining output is dropped, and supports not yet
+// started are cancelled.
+//
+// The game must be frozen if more than one thread is used.  The
+// supports are copied out of the list beforehand, as looking up an
+// element of a List updates its cached position, and so is not safe
+// from several threads at once.
+//
+template <class Support, class Solver> class SupportQueueTask {
+public:
+  SupportQueueTask(const Gambit::List<Support> &p_supports, Solver &p_solver,
+		   std::ostream &p_stream, int p_stopAfter)
+    : m_solver(p_solver), m_stream(p_stream), m_stopAfter(p_stopAfter),
+      m_supports(p_supports.Length()), m_output(p_supports.Length()),
+      m_done(p_supports.Length()), m_nextOutput(1), m_numFound(0)
+  {
+    int i = 1;
+    for (typename Gambit::List<Support>::const_iterator support = p_supports.begin();
+	 support != p_supports.end(); ++support, i++) {
+      m_supports[i] = new Support(*support);
+      m_done[i] = false;
+    }
+  }
+  ~SupportQueueTask()
+  {
+    for (int i = 1; i <= m_supports.Length(); delete m_supports[i++]);
+  }
+
+  int NumSupports(void) const { return m_supports.Length(); }
+
+  void operator()(int i, Gambit::WorkQueue<int> &p_queue)
+  {
+    std::ostringstream output;
+    m_solver(*m_supports[i], output);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_output[i] = output.str();
+    m_done[i] = true;
+    for (; m_nextOutput <= m_done.Length() && m_done[m_nextOutput];
+	 m_nextOutput++) {
+      if (!Flush(m_output[m_nextOutput])) {
+	p_queue.Cancel();
+	m_nextOutput = m_done.Length() + 1;
+	break;
+      }
+      m_output[m_nextOutput] = "";
+    }
+  }
+
+private:
+  Solver &m_solver;
+  std::ostream &m_stream;
+  int m_stopAfter;
+  Gambit::Array<Support *> m_supports;
+  std::mutex m_mutex;
+  Gambit::Array<std::string> m_output;
+  Gambit::Array<bool> m_done;
+  int m_nextOutput, m_numFound;
+
+  /// Writes the output of one support, returning false once enough
+  /// equilibria have been written
+  bool Flush(const std::string &p_output)
+  {
+    std::istringstream lines(p_output);
+    std::string line;
+    while (std::getline(lines, line)) {
+      m_stream << line << std::endl;
+      if (line.compare(0, 3, "NE,") == 0 &&
+	  m_stopAfter > 0 && ++m_numFound >= m_stopAfter) {
+	return false;
+      }
+    }
+    return true;
+  }
+};
+
+template <class Support, class Solver>
+void SolveSupports(const Gambit::List<Support> &p_supports, Solver &p_solver,
+		   int p_stopAfter, int p_numThreads)
+{
+  SupportQueueTask<Support, Solver> task(p_supports, p_solver,
+					 std::cout, p_stopAfter);
+  Gambit::WorkQueue<int> queue;
+  // The most recently pushed item is handed out first, so the supports
+  // are pushed last to first, to be started roughly in order
+  for (int i = task.NumSupports(); i >= 1; queue.Push(i--));
+  queue.Run(p_numThreads, task);
+}
+
+#endif  // SUPPORTQUEUE_H
@@ -51,6 +51,8 @@ void PrintHelp(char *progname)
   std::cerr << "  -S               report equilibria in strategies even for extensive games\n";
   std::cerr << "  -A               compute agent form equilibria\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
+  std::cerr << "  -j THREADS       solve sibling subgames on THREADS threads\n";
+  std::cerr << "                   (0 for one per processor; with -P only)\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -62,6 +64,7 @@ int main(int argc, char *argv[])
 {
   bool quiet = false, reportStrategic = false, solveAgent = false, bySubgames = false;
   bool printDetail = false;
+  int numThreads = 1;
   
   int long_opt_index = 0;
   int optind = argc - 1;
@@ -86,6 +89,9 @@ int main(int argc, char *argv[])
     case 'P':
       bySubgames = true;
       break;
+    case 'j':
+      numThreads = atoi(optarg);
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
@@ -112,7 +118,7 @@ int main(int argc, char *argv[])
   std::istream* input_stream = &std::cin;
   std::ifstream file_stream;
   if (optind < argc) {
-    file_stream.open(argv[optind]);
+    file_stream.open(argv[optind], std::ios::binary);
     if (!file_stream.is_open()) {
       std::ostringstream error_message;
       error_message << argv[0] << ": " << argv[optind];
@@ -153,7 +159,7 @@ int main(int argc, char *argv[])
 	    new EnumPureStrategySolver();
 	  stage = new BehavViaStrategySolver<Rational>(substage);
 	}
-	SubgameBehavSolver<Rational> algorithm(stage, renderer);
+	SubgameBehavSolver<Rational> algorithm(stage, renderer, numThreads);
 	algorithm.Solve(game);
       }
       else {
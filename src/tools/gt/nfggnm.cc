@@ -151,7 +151,7 @@ int main(int argc, char *argv[])
   std::istream* input_stream = &std::cin;
   std::ifstream file_stream;
   if (optind < argc) {
-    file_stream.open(argv[optind]);
+    file_stream.open(argv[optind], std::ios::binary);
     if (!file_stream.is_open()) {
       std::ostringstream error_message;
       error_message << argv[0] << ": " << argv[optind];
@@ -55,6 +55,9 @@ void PrintHelp(char *progname)
   std::cerr << "                   (default is to find all accessible equilbria\n";
   std::cerr << "  -r DEPTH         terminate recursion at DEPTH\n";
   std::cerr << "                   (only if number of equilibria sought is not 1)\n";
+  std::cerr << "  -j THREADS       use THREADS threads (0 for one per processor) to\n";
+  std::cerr << "                   follow paths in strategic games, or to solve\n";
+  std::cerr << "                   sibling subgames with -P\n";
   std::cerr << "  -D               print detailed information about equilibria\n";
   std::cerr << "  -h               print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
@@ -68,7 +71,7 @@ int main(int argc, char *argv[])
   int c;
   bool useFloat = false, useStrategic = false, bySubgames = false, quiet = false;
   bool printDetail = false;
-  int numDecimals = 6, stopAfter = 0, maxDepth = 0;
+  int numDecimals = 6, stopAfter = 0, maxDepth = 0, numThreads = 1;
 
   int long_opt_index = 0;
 /*  struct option long_options[] = {
@@ -102,6 +105,9 @@ int main(int argc, char *argv[])
     case 'r':
       maxDepth = atoi(argv[i + 1]);
       break;
+    case 'j':
+      numThreads = atoi(argv[i + 1]);
+      break;
     case 'S':
       useStrategic = true;
       break;
@@ -129,7 +135,7 @@ int main(int argc, char *argv[])
   std::ifstream file_stream;
   int optind = argc - 1;
   if (optind < argc) {
-    file_stream.open(argv[optind]);
+    file_stream.open(argv[optind], std::ios::binary);
     if (!file_stream.is_open()) {
       std::ostringstream error_message;
       error_message << argv[0] << ": " << argv[optind];
@@ -152,7 +158,7 @@ int main(int argc, char *argv[])
 	  renderer = new MixedStrategyCSVRenderer<double>(std::cout, numDecimals);
 	}
 	NashLcpStrategySolver<double> algorithm(stopAfter, maxDepth,
-						renderer);
+						renderer, numThreads);
 	algorithm.Solve(game);
       }
       else {
@@ -164,7 +170,7 @@ int main(int argc, char *argv[])
 	  renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
 	}
 	NashLcpStrategySolver<Rational> algorithm(stopAfter, maxDepth,
-						  renderer);
+						  renderer, numThreads);
 	algorithm.Solve(game);
       }
     }
@@ -208,7 +214,7 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyCSVRenderer<double>(std::cout, 
 							    numDecimals);
 	  }
-	  SubgameBehavSolver<double> algorithm(stage, renderer);
+	  SubgameBehavSolver<double> algorithm(stage, renderer, numThreads);
 	  algorithm.Solve(game);
 	}
 	else {
@@ -223,7 +229,7 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyCSVRenderer<Rational>(std::cout, 
 							      numDecimals);
 	  }
-	  SubgameBehavSolver<Rational> algorithm(stage, renderer);
+	  SubgameBehavSolver<Rational> algorithm(stage, renderer, numThreads);
 	  algorithm.Solve(game);
 	}
       }
@@ -60,16 +60,8 @@ double AgentLyapunovFunction::Value(const Vector<double> &v) const
 bool AgentLyapunovFunction::Gradient(const Vector<double> &x,
 				     Vector<double> &grad) const
 {
-  const double DELTA = .00001;
   static_cast<Vector<double> &>(m_profile).operator=(x);
-  for (int i = 1; i <= x.Length(); i++) {
-    m_profile[i] += DELTA;
-    double value = m_profile.GetLiapValue();
-    m_profile[i] -= 2.0 * DELTA;
-    value -= m_profile.GetLiapValue();
-    m_profile[i] += DELTA;
-    grad[i] = value / (2.0 * DELTA);
-  }
+  grad = m_profile.GetLiapGradient();
   Project(grad, m_game->NumInfosets());
   return true;
 }
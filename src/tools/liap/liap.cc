@@ -27,6 +27,7 @@
 //#include <unistd.h>
 //#include <getopt.h>
 #include "gambit/gambit.h"
+#include "gambit/nash/multistart.h"
 #include "efgliap.h"
 #include "nfgliap.h"
 
@@ -45,10 +46,14 @@ void PrintHelp(char *progname)
   std::cerr << "Usage: " << progname << " [OPTIONS] [file]\n";
   std::cerr << "If file is not specified, attempts to read game from standard input.\n";
   std::cerr << "With no options, attempts to compute one equilibrium starting at centroid.\n";
+  std::cerr << "An equilibrium within .001 in each probability of one already found\n";
+  std::cerr << "is not reported again.\n";
 
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      print probabilities with DECIMALS digits\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  -j THREADS       solve from starting points in parallel on THREADS\n";
+  std::cerr << "                   threads (0 for one per processor)\n";
   std::cerr << "  -n COUNT         number of starting points to generate\n";
   std::cerr << "  -s FILE          file containing starting points\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
@@ -87,8 +92,11 @@ RandomStrategyProfiles(const Game &p_game, int p_count)
 {
   List<MixedStrategyProfile<double> > profiles;
   for (int i = 1; i <= p_count; i++) {
+    // Each starting point has its own seed, so the set of starting
+    // points does not depend on the number requested.
+    std::mt19937 generator(i);
     MixedStrategyProfile<double> p(p_game->NewMixedStrategyProfile(0.0));
-    p.Randomize();
+    p.Randomize(generator);
     profiles.push_back(p);
   }
   return profiles;
@@ -123,19 +131,52 @@ RandomBehaviorProfiles(const Game &p_game, int p_count)
 {
   List<MixedBehaviorProfile<double> > profiles;
   for (int i = 1; i <= p_count; i++) {
+    std::mt19937 generator(i);
     MixedBehaviorProfile<double> p(p_game);
-    p.Randomize();
+    p.Randomize(generator);
     profiles.push_back(p);
   }
   return profiles;
 }
 
+// Equilibria are found to within a gradient of .001 of the Lyapunov
+// function, so those closer together than this are taken to be the same.
+const double DUPLICATE_TOL = .001;
+
+//
+// Solves from each of a list of starting points by minimizing the
+// Lyapunov function; see MultiStartTask.
+//
+template <class Solver, class Profile>
+class LiapTask : public MultiStartTask<double, Profile> {
+public:
+  LiapTask(const List<Profile> &p_starts,
+	   shared_ptr<StrategyProfileRenderer<double> > p_onEquilibrium,
+	   int p_maxitsN, bool p_verbose)
+    : MultiStartTask<double, Profile>(p_starts, p_onEquilibrium, DUPLICATE_TOL),
+      m_maxitsN(p_maxitsN), m_verbose(p_verbose)
+  { }
+
+protected:
+  void Solve(const Profile &p_start,
+	     shared_ptr<StrategyProfileRenderer<double> > p_onEquilibrium) const
+  {
+    Solver algorithm(m_maxitsN, m_verbose, p_onEquilibrium);
+    algorithm.Solve(p_start);
+  }
+
+private:
+  int m_maxitsN;
+  bool m_verbose;
+};
+
 int main(int argc, char *argv[])
 {
   bool quiet = false, useStrategic = false, useRandom = false, verbose = false;
   int numTries = 10;
   int maxitsN = 100;
   int numDecimals = 6;
+  int numThreads = -1;
   double tolN = 1.0e-10;
   std::string startFile = "";
  
@@ -156,6 +197,9 @@ int main(int argc, char *argv[])
     case 'n':
       numTries = atoi(optarg);
       break;
+    case 'j':
+      numThreads = atoi(optarg);
+      break;
     case 's':
       startFile = optarg;
       break;
@@ -191,7 +235,7 @@ int main(int argc, char *argv[])
   std::istream* input_stream = &std::cin;
   std::ifstream file_stream;
   if (optind < argc) {
-    file_stream.open(argv[optind]);
+    file_stream.open(argv[optind], std::ios::binary);
     if (!file_stream.is_open()) {
       std::ostringstream error_message;
       error_message << argv[0] << ": " << argv[optind];
@@ -203,6 +247,9 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    if (numThreads >= 0) {
+      game->Freeze();
+    }
     if (!game->IsTree() || useStrategic) {
       List<MixedStrategyProfile<double> > starts;
       if (startFile != "") {
@@ -214,12 +261,15 @@ int main(int argc, char *argv[])
 	starts = RandomStrategyProfiles(game, numTries);
       }
 
-      for (int i = 1; i <= starts.size(); i++) {
-	shared_ptr<StrategyProfileRenderer<double> > renderer;
-	renderer = new MixedStrategyCSVRenderer<double>(std::cout,
-							numDecimals);
-	NashLiapStrategySolver algorithm(maxitsN, verbose, renderer);
-	algorithm.Solve(starts[i]);
+      shared_ptr<StrategyProfileRenderer<double> > renderer;
+      renderer = new MixedStrategyCSVRenderer<double>(std::cout, numDecimals);
+      LiapTask<NashLiapStrategySolver, MixedStrategyProfile<double> >
+	task(starts, renderer, maxitsN, verbose);
+      if (numThreads >= 0) {
+	ParallelFor(starts.size(), numThreads, task);
+      }
+      else {
+	for (int i = 1; i <= starts.size(); task(i++));
       }
     }
     else {
@@ -233,12 +283,15 @@ int main(int argc, char *argv[])
 	starts = RandomBehaviorProfiles(game, numTries);
       }
 
-      for (int i = 1; i <= starts.size(); i++) {
-	shared_ptr<StrategyProfileRenderer<double> > renderer;
-	renderer = new BehavStrategyCSVRenderer<double>(std::cout,
-							numDecimals);
-	NashLiapBehavSolver algorithm(maxitsN, verbose, renderer);
-	algorithm.Solve(starts[i]);
+      shared_ptr<StrategyProfileRenderer<double> > renderer;
+      renderer = new BehavStrategyCSVRenderer<double>(std::cout, numDecimals);
+      LiapTask<NashLiapBehavSolver, MixedBehaviorProfile<double> >
+	task(starts, renderer, maxitsN, verbose);
+      if (numThreads >= 0) {
+	ParallelFor(starts.size(), numThreads, task);
+      }
+      else {
+	for (int i = 1; i <= starts.size(); task(i++));
       }
     }
     return 0;
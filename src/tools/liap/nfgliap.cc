@@ -49,37 +49,61 @@ private:
   double Value(const Vector<double> &) const;
   bool Gradient(const Vector<double> &, Vector<double> &) const;
 
-  double LiapDerivValue(int, int, const MixedStrategyProfile<double> &) const;
+  double LiapDerivValue(int, int, int, const MixedStrategyProfile<double> &,
+			const PVector<double> &,
+			const Vector<double> &,
+			const Matrix<double> &) const;
 };
 
+//
+// The values of all strategies, the payoffs to all players, and the
+// payoff Jacobian do not depend on the coordinate with respect to which
+// the derivative is taken.  They are computed once per gradient
+// evaluation and passed in.  Strategies are indexed in the Jacobian in
+// the same order as in the profile; p_index is the index of the
+// coordinate (i1, j1).
+//
 double 
-StrategicLyapunovFunction::LiapDerivValue(int i1, int j1,
-					  const MixedStrategyProfile<double> &p) const
+StrategicLyapunovFunction::LiapDerivValue(int i1, int j1, int p_index,
+					  const MixedStrategyProfile<double> &p,
+					  const PVector<double> &p_values,
+					  const Vector<double> &p_payoffs,
+					  const Matrix<double> &p_jacobian) const
 {
-  GameStrategy wrt_strategy = m_game->Players()[i1]->Strategies()[j1];
   double x = 0.0;
-  for (int i = 1; i <= m_game->NumPlayers(); i++)  {
-    double psum = 0.0;
+  for (int i = 1, k = 1; i <= m_game->NumPlayers(); i++)  {
     GamePlayer player = m_game->Players()[i];
-    for (int j = 1; j <= player->NumStrategies(); j++)  {
-      GameStrategy strategy = player->Strategies()[j];
-      psum += p[strategy];
-      double x1 = p.GetPayoff(strategy) - p.GetPayoff(i);
+    // The derivative of player i's payoff with respect to the coordinate
+    double deriv = 0.0;
+    if (i == i1) {
+      deriv = p_values(i1, j1);
+    }
+    else {
+      for (int j = 0; j < player->NumStrategies(); j++) {
+	if (p[k + j] > 0.0) {
+	  deriv += p[k + j] * p_jacobian(k + j, p_index);
+	}
+      }
+    }
+
+    double psum = 0.0;
+    for (int j = 1; j <= player->NumStrategies(); j++, k++)  {
+      psum += p[k];
+      double x1 = p_values(i, j) - p_payoffs[i];
       if (i1 == i) {
 	if (x1 > 0.0)
-	  x -= x1 * p.GetPayoffDeriv(i, wrt_strategy);
+	  x -= x1 * deriv;
       }
       else if (x1 > 0.0) {
-	x += x1 * (p.GetPayoffDeriv(i, strategy, wrt_strategy) - 
-		   p.GetPayoffDeriv(i, wrt_strategy));
+	x += x1 * (p_jacobian(k, p_index) - deriv);
       }
     }
     if (i == i1)  {
       x += 100.0 * (psum - 1.0);
     }
   }
-  if (p[wrt_strategy] < 0.0) {
-    x += p[wrt_strategy];
+  if (p[p_index] < 0.0) {
+    x += p[p_index];
   }
   return 2.0 * x;
 }
@@ -88,9 +112,21 @@ bool
 StrategicLyapunovFunction::Gradient(const Vector<double> &v, Vector<double> &d) const
 {
   static_cast<Vector<double> &>(m_profile).operator=(v);
+  PVector<double> values(m_game->NumStrategies());
+  Vector<double> payoffs(m_game->NumPlayers());
+  for (int pl = 1; pl <= m_game->NumPlayers(); pl++) {
+    Vector<double> playerValues = m_profile.GetPayoffVector(pl);
+    for (int st = 1; st <= playerValues.Length(); st++) {
+      values(pl, st) = playerValues[st];
+    }
+    payoffs[pl] = m_profile.GetPayoff(pl);
+  }
+  Matrix<double> jacobian(m_profile.MixedProfileLength(),
+			  m_profile.MixedProfileLength());
+  m_profile.GetPayoffJacobian(jacobian);
   for (int pl = 1, ii = 1; pl <= m_game->NumPlayers(); pl++) {
-    for (int st = 1; st <= m_game->Players()[pl]->Strategies().size(); st++) {
-      d[ii++] = LiapDerivValue(pl, st, m_profile);
+    for (int st = 1; st <= m_game->Players()[pl]->Strategies().size(); st++, ii++) {
+      d[ii] = LiapDerivValue(pl, st, ii, m_profile, values, payoffs, jacobian);
     }
   }
   Project(d, m_game->NumStrategies());
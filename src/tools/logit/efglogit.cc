@@ -23,6 +23,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <map>
 #include <gambit/gambit.h>
 #include "logbehav.imp"
 #include "efglogit.h"
@@ -43,6 +44,11 @@ public:
   // Compute the Jacobian matrix at the specified point.
   virtual void GetJacobian(const Vector<double> &p_point,
 			   Matrix<double> &p_matrix) const;
+  // Each equation involves only the actions interacting with its
+  // information set, so the Jacobian is supplied in sparse form.
+  virtual bool HasSparseJacobian(void) const { return true; }
+  virtual void GetSparseJacobian(const Vector<double> &p_point,
+				 Array<std::map<int, double> > &p_rows) const;
 
 private:
   //
@@ -53,9 +59,12 @@ private:
     virtual ~Equation() { }
     virtual double Value(const LogBehavProfile<double> &p_point,
 			 double p_lambda) const = 0;
+    // The nonzero entries of the gradient, keyed by variable, given
+    // the derivatives of action values from GetActionValueJacobian()
     virtual void Gradient(const LogBehavProfile<double> &p_point, 
 			  double p_lambda,
-			  Vector<double> &p_gradient) const = 0;
+			  const Array<std::map<int, double> > &p_jacobian,
+			  std::map<int, double> &p_gradient) const = 0;
   };
 
   //
@@ -66,18 +75,21 @@ private:
   private:
     Game m_game;
     int m_pl, m_iset;
+    // Index in the profile of the first action at the information set
+    int m_first;
     GameInfoset m_infoset;
 
   public:
-    SumToOneEquation(Game p_game, int p_player, int p_infoset)
-      : m_game(p_game), m_pl(p_player), m_iset(p_infoset),
+    SumToOneEquation(Game p_game, int p_player, int p_infoset, int p_first)
+      : m_game(p_game), m_pl(p_player), m_iset(p_infoset), m_first(p_first),
 	m_infoset(p_game->GetPlayer(p_player)->GetInfoset(p_infoset))
     { }
 
     double Value(const LogBehavProfile<double> &p_profile,
 		 double p_lambda) const;
     void Gradient(const LogBehavProfile<double> &p_profile, double p_lambda,
-		  Vector<double> &p_gradient) const;
+		  const Array<std::map<int, double> > &p_jacobian,
+		  std::map<int, double> &p_gradient) const;
   };
 
   //
@@ -89,18 +101,23 @@ private:
   private:
     Game m_game;
     int m_pl, m_iset, m_act;
+    // Index in the profile of the first action at the information set
+    int m_first;
     GameInfoset m_infoset;
 
   public:
-    RatioEquation(Game p_game, int p_player, int p_infoset, int p_action)
+    RatioEquation(Game p_game, int p_player, int p_infoset, int p_action,
+		  int p_first)
       : m_game(p_game), m_pl(p_player), m_iset(p_infoset), m_act(p_action),
+	m_first(p_first),
 	m_infoset(p_game->GetPlayer(p_player)->GetInfoset(p_infoset))
     { }
 
     double Value(const LogBehavProfile<double> &p_profile, 
 		 double p_lambda) const;
     void Gradient(const LogBehavProfile<double> &p_profile, double p_lambda,
-		  Vector<double> &p_gradient) const;
+		  const Array<std::map<int, double> > &p_jacobian,
+		  std::map<int, double> &p_gradient) const;
   };
 
   Array<Equation *> m_equations;
@@ -110,13 +127,14 @@ private:
 AgentQREPathTracer::EquationSystem::EquationSystem(const Game &p_game)
   : m_game(p_game)
 {
-  for (int pl = 1; pl <= m_game->NumPlayers(); pl++) {
+  for (int pl = 1, first = 1; pl <= m_game->NumPlayers(); pl++) {
     GamePlayer player = m_game->GetPlayer(pl);
     for (int iset = 1; iset <= player->NumInfosets(); iset++) {
-      m_equations.Append(new SumToOneEquation(m_game, pl, iset));
+      m_equations.Append(new SumToOneEquation(m_game, pl, iset, first));
       for (int act = 2; act <= player->GetInfoset(iset)->NumActions(); act++) {
-	m_equations.Append(new RatioEquation(m_game, pl, iset, act));
+	m_equations.Append(new RatioEquation(m_game, pl, iset, act, first));
       }
+      first += player->GetInfoset(iset)->NumActions();
     }
   }
 }
@@ -142,28 +160,13 @@ AgentQREPathTracer::EquationSystem::SumToOneEquation::Value(const LogBehavProfil
 void
 AgentQREPathTracer::EquationSystem::SumToOneEquation::Gradient(const LogBehavProfile<double> &p_profile,
 							       double p_lambda,
-							       Vector<double> &p_gradient) const
+							       const Array<std::map<int, double> > &,
+							       std::map<int, double> &p_gradient) const
 {
-  int i = 1;
-  for (int pl = 1; pl <= m_game->NumPlayers(); pl++) {
-    GamePlayer player = m_game->GetPlayer(pl);
-
-    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
-      GameInfoset infoset = player->GetInfoset(iset);
-
-      for (int act = 1; act <= infoset->NumActions(); act++, i++) {
-	if (pl == m_pl && iset == m_iset) {
-	  p_gradient[i] = p_profile.GetProb(pl, iset, act);
-	}
-	else {
-	  p_gradient[i] = 0.0;
-	}
-      }
-    }
+  for (int act = 1; act <= m_infoset->NumActions(); act++) {
+    p_gradient[m_first + act - 1] = p_profile.GetProb(m_pl, m_iset, act);
   }
-
   // Derivative wrt lambda is zero
-  p_gradient[i] = 0.0;
 }
 			       
 
@@ -182,39 +185,28 @@ AgentQREPathTracer::EquationSystem::RatioEquation::Value(const LogBehavProfile<d
 void
 AgentQREPathTracer::EquationSystem::RatioEquation::Gradient(const LogBehavProfile<double> &p_profile,
 							    double p_lambda,
-							    Vector<double> &p_gradient) const
+							    const Array<std::map<int, double> > &p_jacobian,
+							    std::map<int, double> &p_gradient) const
 {
-  int i = 1;
-  for (int pl = 1; pl <= m_game->NumPlayers(); pl++) {
-    GamePlayer player = m_game->GetPlayer(pl);
-    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
-      GameInfoset infoset = player->GetInfoset(iset);
-      for (int act = 1; act <= infoset->NumActions(); act++, i++) {
-	if (infoset == m_infoset) {
-	  if (act == 1) {
-	    p_gradient[i] = -1.0;
-	  }
-	  else if (act == m_act) {
-	    p_gradient[i] = 1.0; 
-	  }
-	  else {
-	    p_gradient[i] = 0.0;
-	  }
-	}
-	else {   // infoset1 != infoset2
-	  p_gradient[i] = 
-	    -p_lambda * 
-	    (p_profile.DiffActionValue(m_infoset->GetAction(m_act),
-				       infoset->GetAction(act)) -
-	     p_profile.DiffActionValue(m_infoset->GetAction(1),
-				       infoset->GetAction(act)));
-	}
-      }
-    }
+  // Actions at other information sets enter only through the action
+  // values, whose derivatives are nonzero only for interacting pairs
+  const std::map<int, double> &row = p_jacobian[m_first + m_act - 1];
+  for (std::map<int, double>::const_iterator entry = row.begin();
+       entry != row.end(); ++entry) {
+    p_gradient[entry->first] -= p_lambda * entry->second;
+  }
+  const std::map<int, double> &row1 = p_jacobian[m_first];
+  for (std::map<int, double>::const_iterator entry = row1.begin();
+       entry != row1.end(); ++entry) {
+    p_gradient[entry->first] += p_lambda * entry->second;
   }
 
-  p_gradient[i] = (p_profile.GetPayoff(m_infoset->GetAction(1)) -
-		   p_profile.GetPayoff(m_infoset->GetAction(m_act)));
+  p_gradient[m_first] = -1.0;
+  p_gradient[m_first + m_act - 1] = 1.0;
+
+  p_gradient[p_profile.Length() + 1] = 
+    (p_profile.GetPayoff(m_infoset->GetAction(1)) -
+     p_profile.GetPayoff(m_infoset->GetAction(m_act)));
 }
 
 
@@ -237,6 +229,24 @@ AgentQREPathTracer::EquationSystem::GetValue(const Vector<double> &p_point,
 void
 AgentQREPathTracer::EquationSystem::GetJacobian(const Vector<double> &p_point, 
 						Matrix<double> &p_matrix) const
+{
+  Array<std::map<int, double> > rows(m_equations.Length());
+  GetSparseJacobian(p_point, rows);
+
+  for (int i = 1; i <= m_equations.Length(); i++) {
+    Vector<double> column(p_point.Length());
+    column = 0.0;
+    for (std::map<int, double>::const_iterator entry = rows[i].begin();
+	 entry != rows[i].end(); ++entry) {
+      column[entry->first] = entry->second;
+    }
+    p_matrix.SetColumn(i, column);
+  }
+}
+
+void
+AgentQREPathTracer::EquationSystem::GetSparseJacobian(const Vector<double> &p_point,
+						      Array<std::map<int, double> > &p_rows) const
 {
   LogBehavProfile<double> profile(m_game);
   for (int i = 1; i <= profile.Length(); i++) {
@@ -244,10 +254,12 @@ AgentQREPathTracer::EquationSystem::GetJacobian(const Vector<double> &p_point,
   }
   double lambda = p_point[p_point.Length()];
 
+  Array<std::map<int, double> > jacobian;
+  profile.GetActionValueJacobian(jacobian);
+
   for (int i = 1; i <= m_equations.Length(); i++) {
-    Vector<double> column(p_point.Length());
-    m_equations[i]->Gradient(profile, lambda, column);
-    p_matrix.SetColumn(i, column);
+    p_rows[i].clear();
+    m_equations[i]->Gradient(profile, lambda, jacobian, p_rows[i]);
   }
 }
 
@@ -24,6 +24,8 @@
 #ifndef LOGBEHAV_H
 #define LOGBEHAV_H
 
+#include <map>
+
 using namespace Gambit;
 
 ///
@@ -196,6 +198,13 @@ public:
   T DiffNodeValue(const GameNode &node, const GamePlayer &player,
 		  const GameAction &oppAction) const;
 
+  /// Computes DiffActionValue(action, oppAction), scaled by the probability
+  /// of oppAction, for all pairs of actions at different information sets
+  /// at once.  Row i of p_jacobian holds the nonzero derivatives of the
+  /// value of the i'th action of the profile, keyed by the index of
+  /// oppAction; pairs which do not interact are omitted.
+  void GetActionValueJacobian(Array<std::map<int, T> > &p_jacobian) const;
+
   //@}
 };
 
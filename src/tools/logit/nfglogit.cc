@@ -62,6 +62,7 @@ StrategicQREPathTracer::EquationSystem::GetValue(const Vector<double> &p_point,
   p_lhs = 0.0;
   for (int rowno = 0, pl = 1; pl <= m_game->NumPlayers(); pl++) {
     GamePlayer player = m_game->Players()[pl];
+    Vector<double> values = profile.GetPayoffVector(player);
     for (size_t st = 1; st <= player->Strategies().size(); st++) {
       rowno++;
       if (st == 1) {
@@ -75,8 +76,7 @@ StrategicQREPathTracer::EquationSystem::GetValue(const Vector<double> &p_point,
 	// This is a ratio equation
 	p_lhs[rowno] = (logprofile[player->GetStrategy(st)] - 
 			logprofile[player->GetStrategy(1)] -
-			lambda * (profile.GetPayoff(player->GetStrategy(st)) -
-				  profile.GetPayoff(player->GetStrategy(1))));
+			lambda * (values[st] - values[1]));
 
       }
     }
@@ -94,10 +94,18 @@ StrategicQREPathTracer::EquationSystem::GetJacobian(const Vector<double> &p_poin
   }
   double lambda = p_point[p_point.Length()];
 
+  // Rows and columns of the payoff Jacobian are indexed in the same
+  // order as the rows and columns of the system
+  Matrix<double> payoffs(profile.MixedProfileLength(), 
+			 profile.MixedProfileLength());
+  profile.GetPayoffJacobian(payoffs);
+
   p_matrix = 0.0;
 
   for (int rowno = 0, i = 1; i <= m_game->NumPlayers(); i++) {
     GamePlayer player = m_game->Players()[i];
+    Vector<double> values = profile.GetPayoffVector(player);
+    int firstrow = rowno + 1;
     for (size_t j = 1; j <= player->Strategies().size(); j++) {
       rowno++;
       if (j == 1) {
@@ -132,19 +140,12 @@ StrategicQREPathTracer::EquationSystem::GetJacobian(const Vector<double> &p_poin
 	    else {
 	      p_matrix(colno, rowno) =
 		-lambda * profile[player2->GetStrategy(m)] *
-		(profile.GetPayoffDeriv(i, 
-					player->GetStrategy(j),
-					player2->GetStrategy(m)) -
-		 profile.GetPayoffDeriv(i, 
-					player->GetStrategy(1),
-					player2->GetStrategy(m)));
+		(payoffs(rowno, colno) - payoffs(firstrow, colno));
 	    }
 	  }
 	}
 	// Fill the last column, the derivative wrt lambda
-	p_matrix(p_matrix.NumRows(), rowno) =
-	  (profile.GetPayoff(player->GetStrategy(1)) - 
-	   profile.GetPayoff(player->GetStrategy(j)));
+	p_matrix(p_matrix.NumRows(), rowno) = values[1] - values[j];
       }
     }
   }
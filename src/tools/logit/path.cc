@@ -23,6 +23,10 @@
 #include <cmath>
 #include <algorithm>   // for std::max
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <set>
+#include <vector>
 
 #include <gambit/gambit.h>
 #include <gambit/sqmatrix.h>
@@ -106,6 +110,246 @@ void NewtonStep(Matrix<double> &q, Matrix<double> &b,
   d = std::sqrt(d);
 }
 
+//
+// LU decomposition of a sparse square matrix, by Gaussian elimination
+// with threshold partial pivoting.  At each step the pivot is taken in
+// the remaining column with fewest nonzeros, from the row with fewest
+// nonzeros among those whose entry is within a factor of the largest
+// in the column; this keeps fill-in low for block-sparse matrices.
+//
+class SparseLU {
+public:
+  // Factors the matrix with the given rows; returns false if singular
+  bool Factor(const Array<std::map<int, double> > &p_rows);
+  // Solves Ax = p_rhs, returning the solution in p_rhs
+  void Solve(Vector<double> &p_rhs) const;
+
+private:
+  typedef std::vector<std::pair<int, double> > SparseRow;
+
+  // Row and column of the pivot at each step
+  std::vector<int> m_pivotRow, m_pivotCol;
+  // The multiples of the pivot row subtracted from other rows at each step
+  std::vector<SparseRow> m_lower;
+  // The pivot row at each step, with the pivot itself first
+  std::vector<SparseRow> m_upper;
+};
+
+bool SparseLU::Factor(const Array<std::map<int, double> > &p_rows)
+{
+  const double c_threshold = 0.1;
+  int n = p_rows.Length();
+
+  std::vector<std::map<int, double> > rows(n + 1);
+  std::vector<std::set<int> > cols(n + 1);
+  for (int i = 1; i <= n; i++) {
+    rows[i] = p_rows[i];
+    for (std::map<int, double>::const_iterator entry = rows[i].begin();
+	 entry != rows[i].end(); ++entry) {
+      cols[entry->first].insert(i);
+    }
+  }
+  // Remaining columns, ordered by their number of nonzeros
+  std::set<std::pair<int, int> > counts;
+  for (int j = 1; j <= n; j++) {
+    counts.insert(std::make_pair((int) cols[j].size(), j));
+  }
+
+  m_pivotRow.assign(n + 1, 0);
+  m_pivotCol.assign(n + 1, 0);
+  m_lower.assign(n + 1, SparseRow());
+  m_upper.assign(n + 1, SparseRow());
+
+  for (int k = 1; k <= n; k++) {
+    int col = counts.begin()->second;
+    counts.erase(counts.begin());
+
+    double maxAbs = 0.0;
+    for (std::set<int>::const_iterator i = cols[col].begin();
+	 i != cols[col].end(); ++i) {
+      maxAbs = std::max(maxAbs, fabs(rows[*i][col]));
+    }
+    if (maxAbs == 0.0) {
+      return false;
+    }
+    int row = 0;
+    for (std::set<int>::const_iterator i = cols[col].begin();
+	 i != cols[col].end(); ++i) {
+      if (fabs(rows[*i][col]) >= c_threshold * maxAbs &&
+	  (row == 0 || rows[*i].size() < rows[row].size())) {
+	row = *i;
+      }
+    }
+
+    m_pivotRow[k] = row;
+    m_pivotCol[k] = col;
+    double pivot = rows[row][col];
+    m_upper[k].push_back(std::make_pair(col, pivot));
+    for (std::map<int, double>::const_iterator entry = rows[row].begin();
+	 entry != rows[row].end(); ++entry) {
+      if (entry->first == col)  continue;
+      m_upper[k].push_back(*entry);
+      counts.erase(std::make_pair((int) cols[entry->first].size(), entry->first));
+      cols[entry->first].erase(row);
+      counts.insert(std::make_pair((int) cols[entry->first].size(), entry->first));
+    }
+
+    cols[col].erase(row);
+    for (std::set<int>::const_iterator i = cols[col].begin();
+	 i != cols[col].end(); ++i) {
+      std::map<int, double> &target = rows[*i];
+      double multiplier = target[col] / pivot;
+      target.erase(col);
+      m_lower[k].push_back(std::make_pair(*i, multiplier));
+      for (size_t e = 1; e < m_upper[k].size(); e++) {
+	int j = m_upper[k][e].first;
+	std::map<int, double>::iterator entry = target.find(j);
+	if (entry != target.end()) {
+	  entry->second -= multiplier * m_upper[k][e].second;
+	}
+	else {
+	  target[j] = -multiplier * m_upper[k][e].second;
+	  counts.erase(std::make_pair((int) cols[j].size(), j));
+	  cols[j].insert(*i);
+	  counts.insert(std::make_pair((int) cols[j].size(), j));
+	}
+      }
+    }
+    cols[col].clear();
+    rows[row].clear();
+  }
+  return true;
+}
+
+void SparseLU::Solve(Vector<double> &p_rhs) const
+{
+  int n = (int) m_pivotRow.size() - 1;
+  for (int k = 1; k <= n; k++) {
+    double value = p_rhs[m_pivotRow[k]];
+    for (size_t e = 0; e < m_lower[k].size(); e++) {
+      p_rhs[m_lower[k][e].first] -= m_lower[k][e].second * value;
+    }
+  }
+
+  Vector<double> x(n);
+  for (int k = n; k >= 1; k--) {
+    double value = p_rhs[m_pivotRow[k]];
+    for (size_t e = 1; e < m_upper[k].size(); e++) {
+      value -= m_upper[k][e].second * x[m_upper[k][e].first];
+    }
+    x[m_pivotCol[k]] = value / m_upper[k][0].second;
+  }
+  p_rhs = x;
+}
+
+//
+// The linear algebra of a predictor-corrector step.  The Jacobian at a
+// point is factored once, and the factorization is used both to find
+// the tangent to the path there, and for each Newton step of the
+// corrector.
+//
+class Linearization {
+public:
+  virtual ~Linearization() { }
+  // Factor the Jacobian at p_point; p_tangent is the tangent at the
+  // last accepted point
+  virtual void Factor(const Vector<double> &p_point,
+		      const Vector<double> &p_tangent) = 0;
+  // Get the tangent at the point last factored
+  virtual void GetTangent(Vector<double> &p_tangent) const = 0;
+  // Take a Newton step from p_point, given the values p_lhs of the
+  // equations there, returning the length of the step in p_dist
+  virtual void Correct(Vector<double> &p_point, Vector<double> &p_lhs,
+		       double &p_dist) const = 0;
+};
+
+//
+// The dense QR decomposition of the Jacobian.  The tangent is the row
+// of Q orthogonal to the range of the Jacobian, and Newton steps are
+// the least-norm solutions of the linearized equations.
+//
+class DenseLinearization : public Linearization {
+public:
+  DenseLinearization(const PathTracer::EquationSystem &p_system, int p_length)
+    : m_system(p_system), m_b(p_length, p_length - 1), m_q(p_length) { }
+
+  void Factor(const Vector<double> &p_point, const Vector<double> &)
+  { m_system.GetJacobian(p_point, m_b);  QRDecomp(m_b, m_q); }
+  void GetTangent(Vector<double> &p_tangent) const
+  { m_q.GetRow(m_q.NumRows(), p_tangent); }
+  void Correct(Vector<double> &p_point, Vector<double> &p_lhs,
+	       double &p_dist) const
+  { NewtonStep(m_q, m_b, p_point, p_lhs, p_dist); }
+
+private:
+  const PathTracer::EquationSystem &m_system;
+  mutable Matrix<double> m_b;
+  mutable SquareMatrix<double> m_q;
+};
+
+//
+// The sparse LU decomposition of the Jacobian, augmented by the tangent
+// at the last accepted point as a final row.  The tangent is the
+// solution of the augmented system with right-hand side (0,...,0,1),
+// so its orientation agrees with the last tangent, and Newton steps are
+// taken orthogonal to the last tangent.
+//
+class SparseLinearization : public Linearization {
+public:
+  SparseLinearization(const PathTracer::EquationSystem &p_system, int p_length)
+    : m_system(p_system), m_length(p_length), m_singular(false) { }
+
+  void Factor(const Vector<double> &p_point, const Vector<double> &p_tangent);
+  void GetTangent(Vector<double> &p_tangent) const;
+  void Correct(Vector<double> &p_point, Vector<double> &p_lhs,
+	       double &p_dist) const;
+
+private:
+  const PathTracer::EquationSystem &m_system;
+  int m_length;
+  bool m_singular;
+  SparseLU m_lu;
+};
+
+void SparseLinearization::Factor(const Vector<double> &p_point,
+				 const Vector<double> &p_tangent)
+{
+  Array<std::map<int, double> > rows(m_length);
+  m_system.GetSparseJacobian(p_point, rows);
+  rows[m_length].clear();
+  for (int i = 1; i <= m_length; i++) {
+    if (p_tangent[i] != 0.0)  rows[m_length][i] = p_tangent[i];
+  }
+  m_singular = !m_lu.Factor(rows);
+}
+
+void SparseLinearization::GetTangent(Vector<double> &p_tangent) const
+{
+  p_tangent = 0.0;
+  p_tangent[m_length] = 1.0;
+  if (m_singular)  return;
+  m_lu.Solve(p_tangent);
+  p_tangent *= 1.0 / std::sqrt(p_tangent.NormSquared());
+}
+
+void SparseLinearization::Correct(Vector<double> &p_point,
+				  Vector<double> &p_lhs, double &p_dist) const
+{
+  if (m_singular) {
+    // Treat as a failed step, so the stepsize is reduced
+    p_dist = std::numeric_limits<double>::infinity();
+    return;
+  }
+  Vector<double> step(m_length);
+  for (int i = 1; i < m_length; i++) {
+    step[i] = p_lhs[i];
+  }
+  step[m_length] = 0.0;
+  m_lu.Solve(step);
+  p_point -= step;
+  p_dist = std::sqrt(step.NormSquared());
+}
+
 }   // end anonymous namespace
 
 
@@ -135,13 +379,23 @@ PathTracer::TracePath(const EquationSystem &p_system,
   // t is current tangent at x; newT is tangent at u, which is the next point.
   Vector<double> t(x.Length()), newT(x.Length());
   Vector<double> y(x.Length() - 1);
-  Matrix<double> b(x.Length(), x.Length() - 1);
-  SquareMatrix<double> q(x.Length());
+
+  std::unique_ptr<Linearization> factors;
+  if (p_system.HasSparseJacobian()) {
+    factors.reset(new SparseLinearization(p_system, x.Length()));
+  }
+  else {
+    factors.reset(new DenseLinearization(p_system, x.Length()));
+  }
+  Linearization &linear = *factors;
 
   p_callback(x, false);
-  p_system.GetJacobian(x, b);
-  QRDecomp(b, q);
-  q.GetRow(q.NumRows(), t);
+  // The sparse tangent is oriented to agree with this initial guess,
+  // which is to follow the path in the direction of increasing lambda
+  t = 0.0;
+  t[t.Length()] = 1.0;
+  linear.Factor(x, t);
+  linear.GetTangent(t);
   
   while (x[x.Length()] >= 0.0 && x[x.Length()] < p_maxLambda) {
     bool accept = true;
@@ -160,8 +414,7 @@ PathTracer::TracePath(const EquationSystem &p_system,
     }
 
     double decel = 1.0 / m_maxDecel;  // initialize deceleration factor
-    p_system.GetJacobian(u, b);
-    QRDecomp(b, q);
+    linear.Factor(u, t);
 
     int iter = 1;
     double disto = 0.0;
@@ -169,7 +422,7 @@ PathTracer::TracePath(const EquationSystem &p_system,
       double dist;
 
       p_system.GetValue(u, y);
-      NewtonStep(q, b, u, y, dist); 
+      linear.Correct(u, y, dist);
 
       if (dist >= c_maxDist) {
 	accept = false;
@@ -222,7 +475,7 @@ PathTracer::TracePath(const EquationSystem &p_system,
     }
 
     // Obtain the tangent at the next step
-    q.GetRow(q.NumRows(), newT); 
+    linear.GetTangent(newT);
 
     // If we are at a bifurcation point, the orientation of the tangent
     // will flip.  This will confuse many criterion functions, especially
@@ -23,6 +23,8 @@
 #ifndef PATH_H
 #define PATH_H
 
+#include <map>
+
 namespace Gambit {
 
 //
@@ -44,6 +46,16 @@ public:
     // Compute the Jacobian matrix at the specified point.
     virtual void GetJacobian(const Vector<double> &p_point,
 			     Matrix<double> &p_matrix) const = 0;
+    // Returns true if the system can compute its Jacobian in sparse
+    // form, in which case the tracer factors it by sparse LU rather
+    // than by dense QR.
+    virtual bool HasSparseJacobian(void) const { return false; }
+    // Compute the nonzero entries of the Jacobian at the specified point.
+    // Entry i of the array is the gradient of the i'th equation, keyed by
+    // the index of the variable; it is column i of GetJacobian()'s matrix.
+    virtual void GetSparseJacobian(const Vector<double> &,
+				   Array<std::map<int, double> > &) const
+    { }
   };
 
   //
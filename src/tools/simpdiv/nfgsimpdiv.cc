@@ -30,6 +30,7 @@
 #include "gambit/gambit.h"
 #include "gambit/nash.h"
 #include "gambit/nash/simpdiv.h"
+#include "gambit/nash/multistart.h"
 
 using namespace Gambit;
 using namespace Gambit::Nash;
@@ -63,8 +64,11 @@ RandomProfiles(const Game &p_game, int p_count, const Rational &denom)
 {
   List<MixedStrategyProfile<Rational> > profiles;
   for (int i = 1; i <= p_count; i++) {
+    // Each starting point has its own seed, so the set of starting
+    // points does not depend on the number requested.
+    std::mt19937 generator(i);
     MixedStrategyProfile<Rational> p(p_game->NewMixedStrategyProfile(Rational(0)));
-    p.Randomize(denom);
+    p.Randomize(denom, generator);
     profiles.push_back(p);
   }
   return profiles;
@@ -84,11 +88,15 @@ void PrintHelp(char *progname)
   PrintBanner(std::cerr);
   std::cerr << "Usage: " << progname << " [OPTIONS] [file]\n";
   std::cerr << "If file is not specified, attempts to read game from standard input.\n";
-  std::cerr << "With no options, computes one approximate Nash equilibrium.\n\n";
+  std::cerr << "With no options, computes one approximate Nash equilibrium.\n";
+  std::cerr << "An equilibrium within 1e-6 in each probability of one already found\n";
+  std::cerr << "is not reported again.\n\n";
 
   std::cerr << "Options:\n";
   std::cerr << "  -g MULT          granularity of grid refinement at each step (default is 2)\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  -j THREADS       solve from starting points in parallel on THREADS\n";
+  std::cerr << "                   threads (0 for one per processor)\n";
   std::cerr << "  -r DENOM         generate random starting points with denominator DENOM\n";
   std::cerr << "  -n COUNT         number of starting points to generate (requires -r)\n";
   std::cerr << "  -s FILE          file containing starting points\n";
@@ -99,11 +107,44 @@ void PrintHelp(char *progname)
   exit(1);
 }
 
+// Equilibria closer together than this are taken to be the same.
+const double DUPLICATE_TOL = 1.0e-6;
+
+//
+// Solves from each of a list of starting points by simplicial
+// subdivision; see MultiStartTask.
+//
+class SimpdivTask
+  : public MultiStartTask<Rational, MixedStrategyProfile<Rational> > {
+public:
+  SimpdivTask(const List<MixedStrategyProfile<Rational> > &p_starts,
+	      shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium,
+	      int p_gridResize, bool p_verbose)
+    : MultiStartTask<Rational, MixedStrategyProfile<Rational> >(p_starts,
+								p_onEquilibrium,
+								DUPLICATE_TOL),
+      m_gridResize(p_gridResize), m_verbose(p_verbose)
+  { }
+
+protected:
+  void Solve(const MixedStrategyProfile<Rational> &p_start,
+	     shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium) const
+  {
+    NashSimpdivStrategySolver algorithm(m_gridResize, 0, m_verbose,
+					p_onEquilibrium);
+    algorithm.Solve(p_start);
+  }
+
+private:
+  int m_gridResize;
+  bool m_verbose;
+};
+
 int main(int argc, char *argv[])
 {
   std::string startFile;
   bool useRandom = false;
-  int randDenom = 1, gridResize = 2, stopAfter = 1;
+  int randDenom = 1, gridResize = 2, stopAfter = 1, numThreads = -1;
   bool verbose = false, quiet = false;
 
   int long_opt_index = 0;
@@ -130,6 +171,9 @@ int main(int argc, char *argv[])
     case 'n':
       stopAfter = atoi(optarg);
       break;
+    case 'j':
+      numThreads = atoi(optarg);
+      break;
     case 's':
       startFile = optarg;
       break;
@@ -161,7 +205,7 @@ int main(int argc, char *argv[])
   std::istream* input_stream = &std::cin;
   std::ifstream file_stream;
   if (optind < argc) {
-    file_stream.open(argv[optind]);
+    file_stream.open(argv[optind], std::ios::binary);
     if (!file_stream.is_open()) {
       std::ostringstream error_message;
       error_message << argv[0] << ": " << argv[optind];
@@ -173,6 +217,9 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    if (numThreads >= 0) {
+      game->Freeze();
+    }
     List<MixedStrategyProfile<Rational> > starts;
     if (startFile != "") {
       std::ifstream startPoints(startFile.c_str());
@@ -188,12 +235,14 @@ int main(int argc, char *argv[])
 	starts[1][game->Players()[pl]->Strategies()[1]] = Rational(1);
       }
     }
-    for (int i = 1; i <= starts.size(); i++) {
-      shared_ptr<StrategyProfileRenderer<Rational> > renderer;
-      renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
-      NashSimpdivStrategySolver algorithm(gridResize, 0, verbose,
-					  renderer);
-      algorithm.Solve(starts[i]);
+    shared_ptr<StrategyProfileRenderer<Rational> > renderer;
+    renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+    SimpdivTask task(starts, renderer, gridResize, verbose);
+    if (numThreads >= 0) {
+      ParallelFor(starts.size(), numThreads, task);
+    }
+    else {
+      for (int i = 1; i <= starts.size(); task(i++));
     }
     return 0;
   }